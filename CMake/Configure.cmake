@@ -28,6 +28,7 @@ option(Graphics_NO_PALETTE          "Disable builtin palette" OFF)
 option(Graphics_OP_CHECKS           "Check function parameters" ON)
 option(Graphics_EXTRA_BUILTIN_FONTS "Include extra fonts in the build. https://fonts.google.com/" OFF)
 option(Graphics_BACKEND_OPENGL      "Compile the OpenGL back end" ON)
+option(Graphics_BACKEND_SOFTWARE    "Compile the software back end" ON)
 option(Graphics_BUILD_TESTS         "Build UnitTests" ON)
 option(Graphics_AUTO_RUN_TESTS      "Adds a custom target that runs on build" OFF)
 option(Graphics_WINMAIN             "Call main function through WinMain" OFF)
@@ -94,3 +95,8 @@ if (Graphics_BACKEND_OPENGL)
     set(OpenGL_LIB ${OPENGL_LIBRARIES})
 endif()
 
+if (Graphics_BACKEND_SOFTWARE)
+    find_package(Threads REQUIRED)
+    set(Threads_LIB ${CMAKE_THREAD_LIBS_INIT})
+endif()
+
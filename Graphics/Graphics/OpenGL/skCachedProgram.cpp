@@ -20,6 +20,17 @@
 -------------------------------------------------------------------------------
 */
 #include "skCachedProgram.h"
+#include "Utils/skMemoryUtils.h"
+
+enum SKcachedUniform
+{
+    SK_CU_ZORDER    = 0x01,
+    SK_CU_VIEW_PROJ = 0x02,
+    SK_CU_MODE      = 0x04,
+    SK_CU_SURFACE   = 0x08,
+    SK_CU_BRUSH     = 0x10,
+    SK_CU_IMAGE     = 0x20,
+};
 
 skCachedProgram::skCachedProgram() :
     m_zOrder(SK_MAX32),
@@ -27,18 +38,55 @@ skCachedProgram::skCachedProgram() :
     m_mode(SK_MAX32),
     m_surface(SK_MAX32),
     m_brush(SK_MAX32),
-    m_ima(SK_MAX32)
+    m_ima(SK_MAX32),
+    m_zOrderValue(0),
+    m_viewProjValue(skMatrix4::Identity),
+    m_modeValue(0),
+    m_surfaceValue{0, 0, 0, 0},
+    m_brushValue{0, 0, 0, 0},
+    m_imaValue(0),
+    m_valid(0),
+    m_issued(0),
+    m_skipped(0)
 {
 }
 
+bool skCachedProgram::isCurrent(SKuint32        bit,
+                                const skScalar* last,
+                                const skScalar* p,
+                                SKuint32        nr)
+{
+    if (m_valid & bit)
+    {
+        SKuint32 i;
+        for (i = 0; i < nr; ++i)
+        {
+            if (last[i] != p[i])
+                break;
+        }
+
+        if (i == nr)
+        {
+            ++m_skipped;
+            return true;
+        }
+    }
+
+    m_valid |= bit;
+    ++m_issued;
+    return false;
+}
 
 void skCachedProgram::setZOrder(skScalar z)
 {
     if (m_zOrder == SK_MAX32)
         this->getUniformLoc("zorder", &m_zOrder);
 
-    if (m_zOrder != SK_NPOS32)
+    if (m_zOrder != SK_NPOS32 && !isCurrent(SK_CU_ZORDER, &m_zOrderValue, &z, 1))
+    {
+        m_zOrderValue = z;
         setUniform1F(m_zOrder, z);
+    }
 }
 
 void skCachedProgram::setViewProj(const skMatrix4& vProj)
@@ -46,8 +94,11 @@ void skCachedProgram::setViewProj(const skMatrix4& vProj)
     if (m_viewProj == SK_MAX32)
         this->getUniformLoc("viewproj", &m_viewProj);
 
-    if (m_viewProj != SK_NPOS32)
+    if (m_viewProj != SK_NPOS32 && !isCurrent(SK_CU_VIEW_PROJ, m_viewProjValue.p, vProj.p, 16))
+    {
+        m_viewProjValue = vProj;
         setUniformMatrix(m_viewProj, vProj.p);
+    }
 }
 
 void skCachedProgram::setImage(SKuint32 ima)
@@ -55,8 +106,18 @@ void skCachedProgram::setImage(SKuint32 ima)
     if (m_ima == SK_MAX32)
         this->getUniformLoc("ima", &m_ima);
 
-    if (m_ima != SK_NPOS32)
+    if (m_ima == SK_NPOS32)
+        return;
+
+    if ((m_valid & SK_CU_IMAGE) && m_imaValue == ima)
+        ++m_skipped;
+    else
+    {
+        m_valid |= SK_CU_IMAGE;
+        m_imaValue = ima;
+        ++m_issued;
         setUniform1I(m_ima, ima);
+    }
 }
 
 void skCachedProgram::setMode(SKuint32 m)
@@ -64,8 +125,18 @@ void skCachedProgram::setMode(SKuint32 m)
     if (m_mode == SK_MAX32)
         this->getUniformLoc("mode", &m_mode);
 
-    if (m_mode != SK_NPOS32)
+    if (m_mode == SK_NPOS32)
+        return;
+
+    if ((m_valid & SK_CU_MODE) && m_modeValue == m)
+        ++m_skipped;
+    else
+    {
+        m_valid |= SK_CU_MODE;
+        m_modeValue = m;
+        ++m_issued;
         setUniform1I(m_mode, m);
+    }
 }
 
 void skCachedProgram::setSurface(const skScalar* p)
@@ -73,8 +144,11 @@ void skCachedProgram::setSurface(const skScalar* p)
     if (m_surface == SK_MAX32)
         this->getUniformLoc("surface", &m_surface);
 
-    if (m_surface != SK_NPOS32)
+    if (m_surface != SK_NPOS32 && !isCurrent(SK_CU_SURFACE, m_surfaceValue, p, 4))
+    {
+        skMemcpy(m_surfaceValue, p, sizeof(skScalar) * 4);
         setUniform4F(m_surface, p);
+    }
 }
 
 void skCachedProgram::setBrush(const skScalar* p)
@@ -82,6 +156,9 @@ void skCachedProgram::setBrush(const skScalar* p)
     if (m_brush == SK_MAX32)
         this->getUniformLoc("brush", &m_brush);
 
-    if (m_brush != SK_NPOS32)
+    if (m_brush != SK_NPOS32 && !isCurrent(SK_CU_BRUSH, m_brushValue, p, 4))
+    {
+        skMemcpy(m_brushValue, p, sizeof(skScalar) * 4);
         setUniform4F(m_brush, p);
+    }
 }
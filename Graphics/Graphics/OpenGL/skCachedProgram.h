@@ -35,11 +35,39 @@ protected:
     SKuint32 m_brush;
     SKuint32 m_ima;
 
+    // the last values sent to each uniform
+    skScalar  m_zOrderValue;
+    skMatrix4 m_viewProjValue;
+    SKuint32  m_modeValue;
+    skScalar  m_surfaceValue[4];
+    skScalar  m_brushValue[4];
+    SKuint32  m_imaValue;
+    SKuint32  m_valid;
+    SKuint32  m_issued;
+    SKuint32  m_skipped;
+
 public:
     skCachedProgram();
 
     ~skCachedProgram() = default;
 
+    void invalidate(void)
+    {
+        m_valid = 0;
+    }
+
+    void getStateCalls(SKuint32& issued, SKuint32& skipped) const
+    {
+        issued  = m_issued;
+        skipped = m_skipped;
+    }
+
+    void resetStateCalls(void)
+    {
+        m_issued  = 0;
+        m_skipped = 0;
+    }
+
     void setZOrder(skScalar z);
 
     void setViewProj(const skMatrix4& vProj);
@@ -51,6 +79,9 @@ public:
     void setSurface(const skScalar* p);
 
     void setBrush(const skScalar* p);
+
+private:
+    bool isCurrent(SKuint32 bit, const skScalar* last, const skScalar* p, SKuint32 nr);
 };
 
 #endif  //_skCachedProgram_h_
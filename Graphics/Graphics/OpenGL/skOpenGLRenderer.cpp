@@ -24,10 +24,18 @@
 #include "OpenGL/skOpenGLVertexBuffer.h"
 #include "OpenGL/skProgram.h"
 #include "Pipeline/ColoredFragment.inl"
+#include "Pipeline/ColoredFragmentColors.inl"
 #include "Pipeline/ColoredVertex.inl"
+#include "Pipeline/ColoredVertexColors.inl"
+#include "Pipeline/ColoredVertexInstanced.inl"
 #include "Pipeline/FontFragment.inl"
 #include "Pipeline/TexturedFragment.inl"
+#include "Pipeline/TexturedFragmentColors.inl"
 #include "Pipeline/TexturedVertex.inl"
+#include "Pipeline/TexturedVertexColors.inl"
+#include "Pipeline/TexturedVertexInstanced.inl"
+#include "Utils/skLogger.h"
+#include "Utils/skMemoryUtils.h"
 #include "Utils/skPlatformHeaders.h"
 #include "Window/OpenGL/skOpenGL.h"
 #include "skCachedProgram.h"
@@ -38,28 +46,122 @@
 #include "skPaint.h"
 #include "skPath.h"
 
-const GLint clear_bits = GL_COLOR_BUFFER_BIT;
+const GLint clear_bits = GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT;
+
+static SKuint32 skOpenGLPackColor(const skScalar* color)
+{
+    // bytes in r, g, b, a order for SK_UBYTE4_8N
+    SKubyte rgba[4];
+    for (int i = 0; i < 4; ++i)
+        rgba[i] = (SKubyte)(skClamp<skScalar>(color[i], 0, 1) * 255 + skScalar(0.5));
+
+    SKuint32 packed;
+    skMemcpy(&packed, rgba, sizeof(SKuint32));
+    return packed;
+}
+
+// Stencil bits in the bound frame buffer. GL_STENCIL_BITS
+// is gone from core profiles, which ask the attachment.
+static SKint32 skOpenGLStencilBits(bool target)
+{
+    GLint bits = 0;
+    glGetIntegerv(GL_STENCIL_BITS, &bits);
+
+#ifdef GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE
+    if (glGetError() != GL_NO_ERROR)
+    {
+        bits = 0;
+        glGetFramebufferAttachmentParameteriv(GL_FRAMEBUFFER,
+                                              target ? GL_STENCIL_ATTACHMENT : GL_STENCIL,
+                                              GL_FRAMEBUFFER_ATTACHMENT_STENCIL_SIZE,
+                                              &bits);
+    }
+#endif
+    return bits;
+}
+
+static bool skOpenGLSameBatch(const SKopenGLBatch& a, const SKopenGLBatch& b)
+{
+    if (a.program != b.program || a.texture != b.texture)
+        return false;
+    if (a.mode != b.mode || a.blend != b.blend)
+        return false;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        if (a.surface[i] != b.surface[i] || a.brush[i] != b.brush[i])
+            return false;
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+        if (a.viewProj.p[i] != b.viewProj.p[i])
+            return false;
+    }
+    return true;
+}
+
+static bool skOpenGLSameCommand(const SKopenGLCommand& a, const SKopenGLCommand& b)
+{
+    return skOpenGLSameBatch(a.state, b.state);
+}
 
 skOpenGLRenderer::skOpenGLRenderer() :
     m_projection(skMatrix4::Identity),
     m_defaultShader(new skCachedProgram()),
     m_fontShader(new skCachedProgram()),
     m_blankShader(new skCachedProgram()),
+    m_defaultColorShader(new skCachedProgram()),
+    m_blankColorShader(new skCachedProgram()),
+    m_defaultInstanceShader(new skCachedProgram()),
+    m_blankInstanceShader(new skCachedProgram()),
     m_viewport(0, 0, 0, 0),
+    m_savedProjection(skMatrix4::Identity),
+    m_savedViewport{0, 0, 0, 0},
     m_fontPath(new skPath()),
+    m_coverPath(new skPath()),
     m_curPath(nullptr),
     m_curPaint(nullptr),
-    m_fillOp(GL_TRIANGLE_STRIP)
+    m_target(nullptr),
+    m_fillOp(0),
+    m_stencilBits(-1),
+    m_state(),
+    m_instances(new skOpenGLVertexBuffer())
 {
     compileBuiltin();
+    invalidateState();
+    resetStateCalls();
+
+    for (SKuint32 i = 0; i < SK_STREAM_LAYOUTS; ++i)
+    {
+        m_streams[i] = new skOpenGLVertexBuffer();
+        m_streams[i]->addElement(SK_ATTR_POSITION, SK_FLOAT2_32);
+
+        if (i & SK_STREAM_UV)
+            m_streams[i]->addElement(SK_ATTR_TEXTURE0, SK_FLOAT2_32);
+        if (i & SK_STREAM_COLORS)
+            m_streams[i]->addElement(SK_ATTR_COLORS, SK_UBYTE4_8N);
+    }
+
+    m_instances->addElement(SK_ATTR_TRANSFORM0, SK_FLOAT3_32);
+    m_instances->addElement(SK_ATTR_TRANSFORM1, SK_FLOAT3_32);
+    m_instances->addElement(SK_ATTR_COLORS, SK_UBYTE4_8N);
 }
 
 skOpenGLRenderer::~skOpenGLRenderer()
 {
+    for (skOpenGLVertexBuffer* stream : m_streams)
+        delete stream;
+    delete m_instances;
     delete m_fontPath;
+    delete m_coverPath;
     delete m_defaultShader;
     delete m_fontShader;
     delete m_blankShader;
+    delete m_defaultColorShader;
+    delete m_blankColorShader;
+    delete m_defaultInstanceShader;
+    delete m_blankInstanceShader;
 }
 
 void skOpenGLRenderer::compileBuiltin(void) const
@@ -79,6 +181,32 @@ void skOpenGLRenderer::compileBuiltin(void) const
                            ColoredFragment);
     m_blankShader->bindAttribute("position", SK_ATTR_POSITION);
     m_blankShader->bindAttribute("textureCoords", SK_ATTR_TEXTURE0);
+
+    m_defaultColorShader->compile(TexturedVertexColors,
+                                  TexturedFragmentColors);
+    m_defaultColorShader->bindAttribute("position", SK_ATTR_POSITION);
+    m_defaultColorShader->bindAttribute("textureCoords", SK_ATTR_TEXTURE0);
+    m_defaultColorShader->bindAttribute("color", SK_ATTR_COLORS);
+
+    m_blankColorShader->compile(ColoredVertexColors,
+                                ColoredFragmentColors);
+    m_blankColorShader->bindAttribute("position", SK_ATTR_POSITION);
+    m_blankColorShader->bindAttribute("color", SK_ATTR_COLORS);
+
+    m_defaultInstanceShader->compile(TexturedVertexInstanced,
+                                     TexturedFragmentColors);
+    m_defaultInstanceShader->bindAttribute("position", SK_ATTR_POSITION);
+    m_defaultInstanceShader->bindAttribute("textureCoords", SK_ATTR_TEXTURE0);
+    m_defaultInstanceShader->bindAttribute("transform0", SK_ATTR_TRANSFORM0);
+    m_defaultInstanceShader->bindAttribute("transform1", SK_ATTR_TRANSFORM1);
+    m_defaultInstanceShader->bindAttribute("color", SK_ATTR_COLORS);
+
+    m_blankInstanceShader->compile(ColoredVertexInstanced,
+                                   ColoredFragmentColors);
+    m_blankInstanceShader->bindAttribute("position", SK_ATTR_POSITION);
+    m_blankInstanceShader->bindAttribute("transform0", SK_ATTR_TRANSFORM0);
+    m_blankInstanceShader->bindAttribute("transform1", SK_ATTR_TRANSFORM1);
+    m_blankInstanceShader->bindAttribute("color", SK_ATTR_COLORS);
 }
 
 void skOpenGLRenderer::projectBox(skScalar x1, skScalar y1, skScalar x2, skScalar y2)
@@ -103,10 +231,13 @@ void skOpenGLRenderer::loadRect(const skRectangle& rect)
 
 void skOpenGLRenderer::clear(void)
 {
-    const skContext& ctx = ref();
-    skRectangle      rect;
+    skRectangle rect;
     rect.setPosition(0, 0);
-    rect.setSize(ctx.getSize());
+
+    if (m_target)
+        rect.setSize(skVector2((skScalar)m_target->getWidth(), (skScalar)m_target->getHeight()));
+    else
+        rect.setSize(ref().getSize());
     clear(rect);
 }
 
@@ -115,6 +246,11 @@ void skOpenGLRenderer::clear(const skRectangle& rect)
     const skContext& ctx   = ref();
     const skColor&   clear = ctx.getContextC(SK_CLEAR_COLOR);
 
+    flushBatch();
+
+    if (m_target)
+        m_target->invalidate();
+
     if (ctx.getContextI(SK_USE_CURRENT_VIEWPORT))
     {
         glClearColor(
@@ -134,6 +270,8 @@ void skOpenGLRenderer::clear(const skRectangle& rect)
     const SKint32 h = (SKint32)rect.height;
 
     glViewport(x, y, w, h);
+    m_viewport = rect;
+
     glClearColor(
         (float)clear.r,
         (float)clear.g,
@@ -143,73 +281,783 @@ void skOpenGLRenderer::clear(const skRectangle& rect)
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
-void skOpenGLRenderer::doPolyFill(void) const
+void skOpenGLRenderer::doPolyFill(void)
 {
     const skContext& ctx = ref();
 
     if (!m_curPaint->m_program)
         return;
 
+    if (m_target)
+        m_target->invalidate();
+
     const bool lines = m_fillOp == GL_LINES || m_fillOp == GL_LINE_STRIP;
 
-    m_curPaint->m_program->enable(true);
-    m_curPaint->m_program->setMode(m_curPaint->m_brushMode);
-    m_curPaint->m_program->setZOrder(0);
+    skCachedProgram* program = m_curPaint->m_program;
+    useProgram(program);
+    program->setMode(m_curPaint->m_brushMode);
+    program->setZOrder(0);
 
     if (m_curPaint->m_brushPattern && !lines)
     {
         m_curPath->makeUV();
 
-        skOpenGLTexture* ima = (skOpenGLTexture*)m_curPaint->m_brushPattern;
+        bindTexture(getImage(m_curPaint->m_brushPattern));
+        program->setImage(0);
+    }
+    else
+        bindTexture(0);
+
+    if (lines)
+        setLineWidth(m_curPaint->m_penWidth > 1 ? m_curPaint->m_penWidth : 1);
+
+    skScalar surface[4], brush[4];
+    getColors(surface, brush);
+
+    program->setSurface(surface);
+
+    if (m_curPaint->m_brushMode != SK_BM_REPLACE)
+        program->setBrush(brush);
+
+    program->setViewProj((m_projection * ctx.getMatrix()).p);
+
+    setBlend(shouldBlend());
+
+    drawPath(program, 0, 0);
+}
+
+void skOpenGLRenderer::doStencilFill(SKint32 op, SKfillRule rule)
+{
+    if (!m_curPaint->m_program)
+        return;
+
+    if (m_target)
+        m_target->invalidate();
+
+    skCachedProgram* program = m_curPaint->m_program;
+    useProgram(program);
+    program->setMode(m_curPaint->m_brushMode);
+    program->setZOrder(0);
+
+    if (m_curPaint->m_brushPattern)
+    {
+        m_curPath->makeUV();
+
+        bindTexture(getImage(m_curPaint->m_brushPattern));
+        program->setImage(0);
+    }
+    else
+        bindTexture(0);
+
+    skScalar surface[4], brush[4];
+    getColors(surface, brush);
+
+    program->setSurface(surface);
+
+    if (m_curPaint->m_brushMode != SK_BM_REPLACE)
+        program->setBrush(brush);
+
+    program->setViewProj((m_projection * ref().getMatrix()).p);
+
+    const bool   evenOdd = rule == SK_EVEN_ODD;
+    const GLuint mask    = evenOdd ? 0x01 : 0xFF;
+
+    // The path counts how many times each pixel is wound, front
+    // faces up and back faces down, or flips the low bit for
+    // even-odd. Nothing reaches the colour buffer yet.
+    glEnable(GL_STENCIL_TEST);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glStencilMask(mask);
+    glStencilFunc(GL_ALWAYS, 0, mask);
+    if (evenOdd)
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT);
+    else
+    {
+        glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_KEEP, GL_INCR_WRAP);
+        glStencilOpSeparate(GL_BACK, GL_KEEP, GL_KEEP, GL_DECR_WRAP);
+    }
+
+    m_fillOp = op;
+    drawPath(program, 0, 0);
+
+    // The bounds are then drawn once where the count is not
+    // zero, which also leaves the stencil zeroed for the next fill.
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    glStencilMask(0xFF);
+    glStencilFunc(GL_NOTEQUAL, 0, mask);
+    glStencilOp(GL_ZERO, GL_ZERO, GL_ZERO);
+
+    setBlend(shouldBlend());
+
+    makeCover(m_curPath);
+    m_curPath = m_coverPath;
+    m_fillOp  = GL_TRIANGLE_FAN;
+    drawPath(program, 0, 0);
+
+    glDisable(GL_STENCIL_TEST);
+}
+
+void skOpenGLRenderer::makeCover(const skPath* pth)
+{
+    const skBoundingBox2D& bb    = pth->getAabb();
+    skContour*             cover = m_coverPath->getContour();
+
+    // the bounds are often the same as the last fill
+    if (cover->vertices.size() == 4 &&
+        cover->vertices[0].x == bb.x1 && cover->vertices[0].y == bb.y1 &&
+        cover->vertices[2].x == bb.x2 && cover->vertices[2].y == bb.y2)
+        return;
+
+    // the same coordinates as skPath::makeUV
+    cover->clear();
+    cover->push_back(skVertex(bb.x1, bb.y1, 0, 1));
+    cover->push_back(skVertex(bb.x2, bb.y1, 1, 1));
+    cover->push_back(skVertex(bb.x2, bb.y2, 1, 0));
+    cover->push_back(skVertex(bb.x1, bb.y2, 0, 0));
+}
+
+bool skOpenGLRenderer::hasStencil(void)
+{
+    if (m_stencilBits == -1)
+        m_stencilBits = skOpenGLStencilBits(m_target != nullptr);
+    return m_stencilBits > 0;
+}
+
+void skOpenGLRenderer::drawPath(const skCachedProgram* program,
+                                SKuint32               firstInstance,
+                                SKuint32               instanceCount)
+{
+    // the blank shader only reads positions
+    const bool texCoords = (getLayout(program) & SK_STREAM_UV) != 0;
+
+    const skContour* contour  = m_curPath->getContour();
+    const skPoly&    vertices = contour->vertices;
+
+    // strips and fans are drawn once for each subpath
+    const bool subpaths = contour->subpathCount() > 1 &&
+                          (m_fillOp == GL_TRIANGLE_FAN || m_fillOp == GL_LINE_STRIP);
+
+    // Without 32 bit indices a wide indexed path is drawn from its
+    // triangles, repeating the vertices they share.
+    const bool unroll = contour->indexed() &&
+                        vertices.size() > SK_BATCH_MAX_VERTICES &&
+                        !skOpenGLVertexBuffer::hasIndex32();
+
+    skOpenGLVertexBuffer* buffer = nullptr;
+    if (!unroll)
+        buffer = (skOpenGLVertexBuffer*)m_curPath->getDrawBuffer(texCoords);
+    if (buffer)
+    {
+        buffer->setInstances(m_instances, firstInstance, instanceCount);
+        if (subpaths)
+            drawSubpaths(buffer, 0);
+        else
+            buffer->fill(m_fillOp);
+        buffer->setInstances(nullptr, 0, 0);
+        return;
+    }
+
+    skOpenGLVertexBuffer* stream = getStream(program);
+
+    if (unroll)
+    {
+        const skIndices& indices = contour->indices;
+
+        m_unrolled.resizeFast(indices.size());
+        for (SKuint32 i = 0; i < indices.size(); ++i)
+            m_unrolled[i] = vertices[indices[i]];
+
+        const SKuint32 first = stream->streamVertices(m_unrolled.ptr(), m_unrolled.size());
+        if (first == SK_NPOS32)
+            return;
+
+        stream->setInstances(m_instances, firstInstance, instanceCount);
+        stream->fill(m_fillOp, first, m_unrolled.size());
+        stream->setInstances(nullptr, 0, 0);
+        return;
+    }
+
+    const SKuint32 first = stream->streamVertices(vertices.ptr(), vertices.size());
+    if (first == SK_NPOS32)
+        return;
+
+    stream->setInstances(m_instances, firstInstance, instanceCount);
+    if (subpaths)
+        drawSubpaths(stream, first);
+    else if (contour->indexed())
+    {
+        SKint32        type;
+        const SKuint32 offset = stream->streamIndices(contour->indices.ptr(),
+                                                      contour->indices.size(),
+                                                      type);
+
+        stream->fillElements(m_fillOp, first, offset, contour->indices.size(), type);
+    }
+    else
+        stream->fill(m_fillOp, first, vertices.size());
+    stream->setInstances(nullptr, 0, 0);
+}
+
+void skOpenGLRenderer::drawSubpaths(const skOpenGLVertexBuffer* buffer, SKuint32 base) const
+{
+    const skContour* contour = m_curPath->getContour();
+
+    for (SKuint32 i = 0; i < contour->subpathCount(); ++i)
+    {
+        SKuint32 first, count;
+        contour->getSubpath(i, first, count);
+        buffer->fill(m_fillOp, base + first, count);
+    }
+}
+
+bool skOpenGLRenderer::fillInstanced(skPath*         pth,
+                                     const skScalar* transforms,
+                                     const SKuint32* colors,
+                                     SKuint32        count)
+{
+    skCachedProgram* program = getInstancedProgram(m_curPaint->m_program);
+    if (!program || !skOpenGLVertexBuffer::hasInstancing())
+        return false;
+
+    if (count == 0 || pth->getContour()->vertices.size() < 3)
+        return true;
+
+    // painter's order, anything batched goes first
+    flushBatch();
+
+    if (m_target)
+        m_target->invalidate();
+
+    skScalar surface[4], brush[4];
+    getColors(surface, brush);
+
+    const skScalar opacity = ref().getContextF(SK_OPACITY);
+    bool           blend   = shouldBlend();
+
+    m_instanceData.resize(count);
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        SKopenGLInstance& inst = m_instanceData[i];
+        const skScalar*   m    = transforms + i * 6;
+
+        for (int r = 0; r < 3; ++r)
+        {
+            inst.transform0[r] = (float)m[r];
+            inst.transform1[r] = (float)m[r + 3];
+        }
+
+        if (colors)
+        {
+            const skColor c(colors[i]);
+
+            const skScalar rgba[4] = {c.r, c.g, c.b, c.a * opacity};
+            inst.color             = skOpenGLPackColor(rgba);
+            blend                  = blend || rgba[3] < 1;
+        }
+        else
+            inst.color = skOpenGLPackColor(surface);
+    }
+
+    const SKuint32 firstInstance = m_instances->stream(m_instanceData.ptr(),
+                                                       count * sizeof(SKopenGLInstance));
+    if (firstInstance == SK_NPOS32)
+        return true;
+
+    m_curPath = pth->getFillPath(m_curPaint->m_fillRule);
+    if (m_curPath->isEmpty())
+        return true;
+
+    m_fillOp = m_curPath->getContour()->indexed() ? GL_TRIANGLES : GL_TRIANGLE_FAN;
+
+    useProgram(program);
+    program->setMode(m_curPaint->m_brushMode);
+    program->setZOrder(0);
+
+    if (m_curPaint->m_brushPattern)
+    {
+        m_curPath->makeUV();
+
+        bindTexture(getImage(m_curPaint->m_brushPattern));
+        program->setImage(0);
+    }
+    else
+        bindTexture(0);
+
+    if (m_curPaint->m_brushMode != SK_BM_REPLACE)
+        program->setBrush(brush);
+
+    program->setViewProj((m_projection * ref().getMatrix()).p);
+
+    setBlend(blend);
+
+    drawPath(program, firstInstance, count);
+
+    m_fillOp = 0;
+    return true;
+}
+
+SKuint32 skOpenGLRenderer::getLayout(const skCachedProgram* program) const
+{
+    SKuint32 layout = 0;
+    if (program != m_blankShader &&
+        program != m_blankColorShader &&
+        program != m_blankInstanceShader)
+        layout |= SK_STREAM_UV;
+    if (program == m_defaultColorShader || program == m_blankColorShader)
+        layout |= SK_STREAM_COLORS;
+    return layout;
+}
+
+skOpenGLVertexBuffer* skOpenGLRenderer::getStream(const skCachedProgram* program) const
+{
+    return m_streams[getLayout(program)];
+}
+
+skCachedProgram* skOpenGLRenderer::getColorProgram(skCachedProgram* program) const
+{
+    if (program == m_defaultShader)
+        return m_defaultColorShader;
+    if (program == m_blankShader)
+        return m_blankColorShader;
+    return nullptr;
+}
+
+skCachedProgram* skOpenGLRenderer::getInstancedProgram(skCachedProgram* program) const
+{
+    if (program == m_defaultShader)
+        return m_defaultInstanceShader;
+    if (program == m_blankShader)
+        return m_blankInstanceShader;
+    return nullptr;
+}
+
+void skOpenGLRenderer::useProgram(skCachedProgram* program)
+{
+    if (m_state.programBound == 1 && m_state.program == program)
+    {
+        ++m_state.skipped;
+        return;
+    }
+
+    ++m_state.issued;
+    if (program)
+        program->enable(true);
+    else
+        glUseProgram(0);
+
+    m_state.program      = program;
+    m_state.programBound = 1;
+}
+
+void skOpenGLRenderer::bindTexture(SKuint32 texture)
+{
+    const SKint32 enable = texture != 0 ? 1 : 0;
+    if (m_state.texture2D == enable)
+        ++m_state.skipped;
+    else
+    {
+        ++m_state.issued;
+        if (enable)
+            glEnableTexture2D();
+        else
+            glDisableTexture2D();
+        m_state.texture2D = enable;
+    }
+
+    // an unused binding is left alone
+    if (!texture)
+        return;
 
-        glEnableTexture2D();
+    if (m_state.unit == 0)
+        ++m_state.skipped;
+    else
+    {
+        ++m_state.issued;
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, ima->getImage());
+        m_state.unit = 0;
+    }
 
-        m_curPaint->m_program->setImage(0);
+    if (m_state.texture == texture)
+        ++m_state.skipped;
+    else
+    {
+        ++m_state.issued;
+        glBindTexture(GL_TEXTURE_2D, texture);
+        m_state.texture = texture;
     }
+}
 
-    if (lines && m_curPaint->m_penWidth > 1)
+void skOpenGLRenderer::setBlend(bool blend)
+{
+    if (m_state.blend == (blend ? 1 : 0))
     {
-        glEnableLineSmooth();
-        glLineWidth(m_curPaint->m_penWidth);
+        ++m_state.skipped;
+        return;
     }
 
-    const skScalar& opacity = ref().getContextF(SK_OPACITY);
+    ++m_state.issued;
+    if (blend)
+        glEnable(GL_BLEND);
+    else
+        glDisable(GL_BLEND);
+    m_state.blend = blend ? 1 : 0;
+}
+
+void skOpenGLRenderer::setLineWidth(skScalar width)
+{
+    const SKint32 smooth = width > 1 ? 1 : 0;
+    if (m_state.lineSmooth == smooth)
+        ++m_state.skipped;
+    else
+    {
+        ++m_state.issued;
+        if (smooth)
+            glEnableLineSmooth();
+        else
+            glDisableLineSmooth();
+        m_state.lineSmooth = smooth;
+    }
+
+    if (m_state.lineWidth == width)
+        ++m_state.skipped;
+    else
+    {
+        ++m_state.issued;
+        glLineWidth(width);
+        m_state.lineWidth = width;
+    }
+}
+
+void skOpenGLRenderer::invalidateState(void)
+{
+    m_state.program      = nullptr;
+    m_state.programBound = -1;
+    m_state.texture      = SK_NPOS32;
+    m_state.texture2D    = -1;
+    m_state.unit         = -1;
+    m_state.blend        = -1;
+    m_state.lineSmooth   = -1;
+    m_state.lineWidth    = -1;
+
+    m_defaultShader->invalidate();
+    m_fontShader->invalidate();
+    m_blankShader->invalidate();
+    m_defaultColorShader->invalidate();
+    m_blankColorShader->invalidate();
+    m_defaultInstanceShader->invalidate();
+    m_blankInstanceShader->invalidate();
+
+    skOpenGLVertexBuffer::invalidate();
+}
+
+void skOpenGLRenderer::restoreState(void)
+{
+    // Leave GL as it was found for anything
+    // else that draws into the same context.
+    useProgram(nullptr);
+    bindTexture(0);
+    setBlend(false);
+    setLineWidth(1);
+    skOpenGLVertexBuffer::unbindVertexArray();
+}
+
+SKuint32 skOpenGLRenderer::getImage(skTexture* texture)
+{
+    skOpenGLTexture* ima = (skOpenGLTexture*)texture;
+    if (!ima->isDirty())
+        return ima->getImage();
 
-    skScalar col[] = {
-        m_curPaint->m_surfaceColor.r,
-        m_curPaint->m_surfaceColor.g,
-        m_curPaint->m_surfaceColor.b,
-        m_curPaint->m_surfaceColor.a * opacity,
+    const SKuint32 name = ima->getImage();
+
+    // the upload changed the binding behind the cache
+    m_state.texture   = SK_NPOS32;
+    m_state.texture2D = -1;
+    return name;
+}
+
+void skOpenGLRenderer::getStateCalls(SKuint32& issued, SKuint32& skipped) const
+{
+    issued  = m_state.issued;
+    skipped = m_state.skipped;
+
+    const skCachedProgram* programs[7] = {
+        m_defaultShader,
+        m_fontShader,
+        m_blankShader,
+        m_defaultColorShader,
+        m_blankColorShader,
+        m_defaultInstanceShader,
+        m_blankInstanceShader,
     };
+    for (const skCachedProgram* program : programs)
+    {
+        SKuint32 pi, ps;
+        program->getStateCalls(pi, ps);
 
-    m_curPaint->m_program->setSurface(col);
+        issued += pi;
+        skipped += ps;
+    }
+}
 
-    if (m_curPaint->m_brushMode != SK_BM_REPLACE)
+void skOpenGLRenderer::resetStateCalls(void)
+{
+    m_state.issued  = 0;
+    m_state.skipped = 0;
+
+    m_defaultShader->resetStateCalls();
+    m_fontShader->resetStateCalls();
+    m_blankShader->resetStateCalls();
+    m_defaultColorShader->resetStateCalls();
+    m_blankColorShader->resetStateCalls();
+    m_defaultInstanceShader->resetStateCalls();
+    m_blankInstanceShader->resetStateCalls();
+}
+
+void skOpenGLRenderer::getColors(skScalar* surface, skScalar* brush) const
+{
+    const skScalar& opacity = ref().getContextF(SK_OPACITY);
+
+    surface[0] = m_curPaint->m_surfaceColor.r;
+    surface[1] = m_curPaint->m_surfaceColor.g;
+    surface[2] = m_curPaint->m_surfaceColor.b;
+    surface[3] = m_curPaint->m_surfaceColor.a * opacity;
+
+    brush[0] = m_curPaint->m_brushColor.r;
+    brush[1] = m_curPaint->m_brushColor.g;
+    brush[2] = m_curPaint->m_brushColor.b;
+    brush[3] = m_curPaint->m_brushColor.a * opacity;
+}
+
+bool skOpenGLRenderer::canBatch(void) const
+{
+    if (!ref().getContextI(SK_BATCH_DRAWS) || !m_curPaint->m_program)
+        return false;
+
+    // a path wider than a batch would need 32 bit indices
+    if (m_curPath->getContour()->vertices.size() > SK_BATCH_MAX_VERTICES)
+        return false;
+
+    // only triangles can be joined into one draw
+    return m_fillOp == GL_TRIANGLE_FAN || m_fillOp == GL_TRIANGLES;
+}
+
+void skOpenGLRenderer::appendBatch(void)
+{
+    const skContour* contour = m_curPath->getContour();
+    const skPoly&    src     = contour->vertices;
+    const SKuint32   nr      = src.size();
+    if (nr < 3)
+        return;
+
+    // The batch is drawn as one indexed triangle list,
+    // so fans only add indices, not repeated vertices.
+    SKuint32 nrIndices = nr;
+    if (contour->indexed())
+        nrIndices = contour->indices.size();
+    else if (m_fillOp == GL_TRIANGLE_FAN)
+        nrIndices = (nr - 2) * 3;
+
+    if (m_queueVertices.size() + nr > SK_BATCH_MAX_VERTICES)
+        flushBatch();
+
+    SKopenGLCommand cmd;
+    cmd.state.program = m_curPaint->m_program;
+    cmd.state.texture = 0;
+    cmd.state.mode    = m_curPaint->m_brushMode;
+    cmd.state.blend   = shouldBlend();
+
+    if (m_curPaint->m_brushPattern)
+    {
+        m_curPath->makeUV();
+        cmd.state.texture = getImage(m_curPaint->m_brushPattern);
+    }
+
+    getColors(cmd.state.surface, cmd.state.brush);
+    cmd.state.viewProj = m_projection * ref().getMatrix();
+
+    // The surface colour goes into the vertices, so shapes
+    // that only differ by colour share a draw.
+    SKuint32         color   = 0;
+    skCachedProgram* colored = getColorProgram(cmd.state.program);
+    if (colored)
     {
-        col[0] = m_curPaint->m_brushColor.r;
-        col[1] = m_curPaint->m_brushColor.g;
-        col[2] = m_curPaint->m_brushColor.b;
-        col[3] = m_curPaint->m_brushColor.a * opacity;
-        m_curPaint->m_program->setBrush(col);
+        color             = skOpenGLPackColor(cmd.state.surface);
+        cmd.state.program = colored;
+        for (int i = 0; i < 4; ++i)
+            cmd.state.surface[i] = 0;
     }
 
-    m_curPaint->m_program->setViewProj((m_projection * ctx.getMatrix()).p);
+    // the brush is only read when mixing with it
+    if (cmd.state.mode == SK_BM_REPLACE)
+    {
+        for (int i = 0; i < 4; ++i)
+            cmd.state.brush[i] = 0;
+    }
 
-    if (m_curPath->getBuffer())
-        m_curPath->getBuffer()->fill(m_fillOp);
+    // Commands only swap places when they do not overlap,
+    // and that is tested after projection so that any two
+    // commands can be compared.
+    const skBoundingBox2D& bb = m_curPath->getAabb();
+    const skScalar*        m  = cmd.state.viewProj.p;
 
-    m_curPaint->m_program->enable(false);
+    const skScalar cx[4] = {bb.x1, bb.x2, bb.x2, bb.x1};
+    const skScalar cy[4] = {bb.y1, bb.y1, bb.y2, bb.y2};
 
-    if (m_curPaint->m_brushPattern && !lines)
-        glDisableTexture2D();
+    cmd.bounds.clear();
+    for (int i = 0; i < 4; ++i)
+    {
+        skScalar px = m[0] * cx[i] + m[1] * cy[i] + m[3];
+        skScalar py = m[4] * cx[i] + m[5] * cy[i] + m[7];
+
+        const skScalar pw = m[12] * cx[i] + m[13] * cy[i] + m[15];
+        if (!skIsZero(pw))
+        {
+            px /= pw;
+            py /= pw;
+        }
+        cmd.bounds.compare(px, py);
+    }
+
+    cmd.first      = m_queueVertices.size();
+    cmd.count      = nr;
+    cmd.firstIndex = m_queueIndices.size();
+    cmd.indexCount = nrIndices;
+    cmd.next       = -1;
+    m_queue.push_back(cmd);
+
+    m_queueVertices.resize(cmd.first + nr);
+    m_queueColors.resize(cmd.first + nr);
+
+    skVertex* dst  = m_queueVertices.ptr() + cmd.first;
+    SKuint32* cdst = m_queueColors.ptr() + cmd.first;
+    for (SKuint32 i = 0; i < nr; ++i)
+    {
+        dst[i]  = src[i];
+        cdst[i] = color;
+    }
+
+    // indices are relative to the command's first vertex
+    SKuint32 pos = cmd.firstIndex;
+    m_queueIndices.resize(pos + nrIndices);
+
+    SKuint32* idx = m_queueIndices.ptr();
+    if (contour->indexed())
+    {
+        for (SKuint32 i = 0; i < nrIndices; ++i)
+            idx[pos++] = contour->indices[i];
+    }
+    else if (m_fillOp == GL_TRIANGLE_FAN)
+    {
+        for (SKuint32 i = 1; i + 1 < nr; ++i)
+        {
+            idx[pos++] = 0;
+            idx[pos++] = i;
+            idx[pos++] = i + 1;
+        }
+    }
+    else
+    {
+        for (SKuint32 i = 0; i < nr; ++i)
+            idx[pos++] = i;
+    }
+}
+
+void skOpenGLRenderer::sortBatches(bool reorder)
+{
+    // Without reordering a command can only join the batch before
+    // it. With reordering it may look back over recent batches.
+    skSortBatches(m_queue,
+                  m_batches,
+                  reorder ? SK_REORDER_LOOKBACK : 1,
+                  skOpenGLSameCommand);
+
+    // Lay the vertices out in draw order and rebase each
+    // command's indices onto the first vertex of its batch.
+    m_batchVertices.resize(m_queueVertices.size());
+    m_batchIndices.resize(m_queueIndices.size());
+    m_batchColors.resize(m_queueColors.size());
+
+    const skVertex* src  = m_queueVertices.ptr();
+    skVertex*       dst  = m_batchVertices.ptr();
+    const SKuint32* isrc = m_queueIndices.ptr();
+    SKuint32*       idst = m_batchIndices.ptr();
+    SKuint32        pos  = 0;
+    SKuint32        ipos = 0;
+
+    for (SKuint32 b = 0; b < m_batches.size(); ++b)
+    {
+        SKbatchList& batch = m_batches[b];
+        batch.first              = pos;
+        batch.firstIndex         = ipos;
+
+        for (SKint32 i = batch.head; i != -1; i = m_queue[i].next)
+        {
+            const SKopenGLCommand& cmd = m_queue[i];
+            for (SKuint32 v = 0; v < cmd.indexCount; ++v)
+                idst[ipos++] = pos - batch.first + isrc[cmd.firstIndex + v];
+            for (SKuint32 v = 0; v < cmd.count; ++v)
+            {
+                m_batchColors[pos] = m_queueColors[cmd.first + v];
+                dst[pos++]         = src[cmd.first + v];
+            }
+        }
+        batch.count      = pos - batch.first;
+        batch.indexCount = ipos - batch.firstIndex;
+    }
+}
+
+void skOpenGLRenderer::flushBatch(void)
+{
+    if (m_queue.empty())
+        return;
+
+    sortBatches(ref().getContextI(SK_REORDER_DRAWS) != 0);
+
+    if (m_target)
+        m_target->invalidate();
 
-    if (lines && m_curPaint->m_penWidth > 1)
+    for (SKuint32 b = 0; b < m_batches.size(); ++b)
     {
-        glDisableLineSmooth();
-        glLineWidth(1);
+        const SKbatchList& batch = m_batches[b];
+        const SKopenGLBatch&     state = m_queue[batch.head].state;
+
+        skCachedProgram* program = state.program;
+
+        // each batch goes up in the smallest layout its shader reads
+        skOpenGLVertexBuffer* stream = getStream(program);
+
+        const SKuint32 first = stream->streamVertices(m_batchVertices.ptr() + batch.first,
+                                                      batch.count,
+                                                      m_batchColors.ptr() + batch.first);
+        SKint32        type;
+        const SKuint32 offset = stream->streamIndices(m_batchIndices.ptr() + batch.firstIndex,
+                                                      batch.indexCount,
+                                                      type);
+        if (first == SK_NPOS32 || offset == SK_NPOS32)
+            continue;
+
+        useProgram(program);
+        program->setMode(state.mode);
+        program->setZOrder(0);
+
+        bindTexture(state.texture);
+        if (state.texture)
+            program->setImage(0);
+
+        program->setSurface(state.surface);
+        if (state.mode != SK_BM_REPLACE)
+            program->setBrush(state.brush);
+        program->setViewProj(state.viewProj.p);
+
+        setBlend(state.blend);
+
+        stream->fillElements(GL_TRIANGLES, first, offset, batch.indexCount, type);
     }
+
+    m_queue.resizeFast(0);
+    m_queueVertices.resizeFast(0);
+    m_queueIndices.resizeFast(0);
+    m_queueColors.resizeFast(0);
 }
 
 bool skOpenGLRenderer::shouldBlend() const
@@ -219,13 +1067,14 @@ bool skOpenGLRenderer::shouldBlend() const
         blend = m_curPaint->m_surfaceColor.a < 1.f || m_curPaint->m_brushPattern;
     if (!blend)
         blend = m_curPaint->m_brushMode != SK_BM_REPLACE;
-    if (!blend)
-        blend = m_curPaint->m_penWidth > 1.f;
+    if (!blend && m_curPaint->m_penWidth > 1.f)
+        blend = m_fillOp == GL_LINES || m_fillOp == GL_LINE_STRIP || m_fillOp == GL_POINTS;
     return blend;
 }
 
 void skOpenGLRenderer::fill(skPath* pth)
 {
+    pth       = pth->getSimplePath();
     m_curPath = pth;
 
     if (m_fillOp != GL_TRIANGLE_STRIP && m_fillOp != GL_TRIANGLES)
@@ -241,20 +1090,51 @@ void skOpenGLRenderer::fill(skPath* pth)
 #endif
     }
 
-    const bool blend = shouldBlend();
-    if (blend)
-        glEnable(GL_BLEND);
+    // Anything that is not convex fills from its triangles,
+    // or through the stencil buffer when the paint asks for it.
+    if (m_fillOp == GL_TRIANGLE_FAN &&
+        m_curPaint->m_fillMode == SK_FILL_STENCIL &&
+        !pth->getContour()->indexed() &&
+        !pth->isConvex() &&
+        hasStencil())
+    {
+        flushBatch();
+        doStencilFill(GL_TRIANGLE_FAN, m_curPaint->m_fillRule);
 
-    doPolyFill();
+        m_fillOp = 0;
+        return;
+    }
 
-    if (blend)
-        glDisable(GL_BLEND);
+    if (m_fillOp == GL_TRIANGLE_FAN)
+    {
+        m_curPath = pth->getFillPath(m_curPaint->m_fillRule);
+        if (m_curPath->isEmpty())
+        {
+            m_fillOp = 0;
+            return;
+        }
+
+        if (m_curPath->getContour()->indexed())
+            m_fillOp = GL_TRIANGLES;
+    }
+
+    if (canBatch())
+    {
+        appendBatch();
+        m_fillOp = 0;
+        return;
+    }
+
+    // painter's order, anything batched goes first
+    flushBatch();
+    doPolyFill();
 
     m_fillOp = 0;
 }
 
 void skOpenGLRenderer::stroke(skPath* pth)
 {
+    pth       = pth->getSimplePath();
     m_curPath = pth;
     m_fillOp  = GL_LINE_STRIP;
 
@@ -271,17 +1151,78 @@ void skOpenGLRenderer::stroke(skPath* pth)
 #endif
     }
 
-    const bool blend = shouldBlend();
-    if (blend)
-        glEnable(GL_BLEND);
+    // dashes are cut into a line list, then drawn like any other
+    if (m_fillOp != GL_POINTS &&
+        m_curPaint->m_penStyle == SK_PS_DASHED &&
+        !m_curPaint->m_dashes.empty())
+    {
+        m_curPath = pth->getDashPath(m_curPaint->m_dashes,
+                                     m_curPaint->m_dashPhase,
+                                     m_fillOp == GL_LINES);
+        if (m_curPath->isEmpty())
+        {
+            m_fillOp = 0;
+            return;
+        }
+        m_fillOp = GL_LINES;
+    }
+
+    // Wide lines are drawn from their triangles, which keeps the
+    // joins and caps and does not depend on the driver's widest line.
+    // The triangles overlap at the joins, so anything that blends is
+    // counted into the stencil first and covered once.
+    if (m_fillOp != GL_POINTS && m_curPaint->m_penWidth > 1)
+    {
+        m_curPath = m_curPath->getStrokePath(m_curPaint->m_penWidth,
+                                             m_curPaint->m_penJoin,
+                                             m_curPaint->m_penCap,
+                                             m_fillOp == GL_LINES);
+        if (m_curPath->isEmpty())
+        {
+            m_fillOp = 0;
+            return;
+        }
+
+        m_fillOp = GL_TRIANGLES;
+        if (shouldBlend() && hasStencil())
+        {
+            flushBatch();
+            doStencilFill(GL_TRIANGLES, SK_NON_ZERO);
+
+            m_fillOp = 0;
+            return;
+        }
 
+        if (canBatch())
+        {
+            appendBatch();
+            m_fillOp = 0;
+            return;
+        }
+    }
+
+    flushBatch();
     doPolyFill();
 
-    if (blend)
-        glDisable(GL_BLEND);
     m_fillOp = 0;
 }
 
+void skOpenGLRenderer::flush(void)
+{
+    flushBatch();
+    restoreState();
+
+    // other code may draw into the context before the next
+    // frame, so nothing cached is trusted past this point
+    invalidateState();
+
+    // a new frame starts with a new stream store
+    for (skOpenGLVertexBuffer* stream : m_streams)
+        stream->discard();
+    m_instances->discard();
+    glFlush();
+}
+
 void skOpenGLRenderer::displayString(skFont*     font,
                                      const char* str,
                                      SKuint32    len,
@@ -309,22 +1250,111 @@ void skOpenGLRenderer::displayString(skCachedString* str)
     SK_CHECK_PARAM(str, SK_RETURN_VOID);
     SK_CHECK_PARAM(m_ctx, SK_RETURN_VOID);
 
-    skFont* fnt = m_ctx->getWorkFont();
+    displayString(m_ctx->getWorkFont(), str->getPath());
+}
 
-    SK_CHECK_PARAM(fnt, SK_RETURN_VOID);
-    skOpenGLTexture* img = (skOpenGLTexture*)fnt->getImage();
+void skOpenGLRenderer::displayString(skFont* font, skPath* path)
+{
+    SK_CHECK_PARAM(font, SK_RETURN_VOID);
+    SK_CHECK_PARAM(path, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_curPaint, SK_RETURN_VOID);
+
+    skOpenGLTexture* img = (skOpenGLTexture*)font->getImage();
     SK_CHECK_PARAM(img, SK_RETURN_VOID);
 
     m_curPaint->m_brushPattern = img;
     m_curPaint->m_program      = m_fontShader;
 
     m_fillOp = GL_TRIANGLES;
-    fill(str->getPath());
+    fill(path);
 
     m_curPaint->m_brushPattern = nullptr;
     m_curPaint->m_program      = nullptr;
 }
 
+skTexture* skOpenGLRenderer::getTarget(void)
+{
+    // drawing goes to the window's frame buffer
+    return nullptr;
+}
+
+void skOpenGLRenderer::bindTarget(skTexture* target)
+{
+    flushBatch();
+
+    skOpenGLTexture* tex = (skOpenGLTexture*)target;
+
+    GLuint fbo = 0;
+    if (tex)
+    {
+        // creating the frame buffer may upload the texture
+        if (tex->isDirty())
+            getImage(tex);
+
+        fbo = tex->getFrameBuffer();
+        if (!fbo)
+        {
+            skLogd(LD_ERROR, "Failed to create a frame buffer for the render target\n");
+            tex = nullptr;
+        }
+    }
+
+    // the context's view comes back when the target is unbound
+    if (!m_target && tex)
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+
+        for (int i = 0; i < 4; ++i)
+            m_savedViewport[i] = (SKint32)viewport[i];
+        m_savedProjection = m_projection;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+
+    if (tex)
+    {
+        const GLsizei w = (GLsizei)tex->getWidth();
+        const GLsizei h = (GLsizei)tex->getHeight();
+
+        glViewport(0, 0, w, h);
+        m_viewport = skRectangle(0, 0, (skScalar)w, (skScalar)h);
+    }
+    else if (m_target)
+    {
+        const SKint32* v = m_savedViewport;
+        glViewport(v[0], v[1], v[2], v[3]);
+
+        m_viewport   = skRectangle((skScalar)v[0], (skScalar)v[1], (skScalar)v[2], (skScalar)v[3]);
+        m_projection = m_savedProjection;
+    }
+
+    m_target      = tex;
+    m_stencilBits = -1;
+}
+
+void skOpenGLRenderer::resolveTarget(skTexture* target)
+{
+    flushBatch();
+
+    // only textures that have been drawn into have anything to read back
+    if (target)
+        ((skOpenGLTexture*)target)->download();
+}
+
+void skOpenGLRenderer::readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest)
+{
+    SK_CHECK_PARAM(dest, SK_RETURN_VOID);
+
+    if (w <= 0 || h <= 0)
+        return;
+
+    flushBatch();
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(x, y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, dest);
+}
+
 void skOpenGLRenderer::selectPaint(skPaint* paint)
 {
     m_curPaint = paint;
@@ -22,11 +22,70 @@
 #ifndef _skOpenGLRenderer_h_
 #define _skOpenGLRenderer_h_
 
+#include "Math/skBoundingBox2D.h"
+#include "skBatchList.h"
+#include "skContour.h"
 #include "skRender.h"
 
+#define SK_BATCH_MAX_VERTICES 0x10000  // the most 16 bit indices reach
+#define SK_REORDER_LOOKBACK 16
+
+// stream layouts, by the attributes a shader reads
+#define SK_STREAM_UV 0x01
+#define SK_STREAM_COLORS 0x02
+#define SK_STREAM_LAYOUTS 4
+
 class skVertexBuffer;
 class skCachedProgram;
 class skCachedString;
+class skOpenGLTexture;
+class skOpenGLVertexBuffer;
+
+typedef struct SKopenGLBatch
+{
+    skCachedProgram* program;
+    SKuint32         texture;
+    SKint32          mode;
+    bool             blend;
+    skScalar         surface[4];
+    skScalar         brush[4];
+    skMatrix4        viewProj;
+} SKopenGLBatch;
+
+// The last state handed to GL. Values of -1 and SK_NPOS32
+// are unknown and always get sent.
+typedef struct SKopenGLState
+{
+    skCachedProgram* program;
+    SKint32          programBound;
+    SKuint32         texture;
+    SKint32          texture2D;
+    SKint32          unit;
+    SKint32          blend;
+    SKint32          lineSmooth;
+    skScalar         lineWidth;
+    SKuint32         issued;
+    SKuint32         skipped;
+} SKopenGLState;
+
+// per instance data for skOpenGLRenderer::fillInstanced
+typedef struct SKopenGLInstance
+{
+    float    transform0[3];
+    float    transform1[3];
+    SKuint32 color;
+} SKopenGLInstance;
+
+typedef struct SKopenGLCommand
+{
+    SKopenGLBatch   state;
+    skBoundingBox2D bounds;  // in clip space
+    SKuint32        first;
+    SKuint32        count;
+    SKuint32        firstIndex;
+    SKuint32        indexCount;
+    SKint32         next;  // the next command in the same batch
+} SKopenGLCommand;
 
 class skOpenGLRenderer : public skRenderer
 {
@@ -35,11 +94,34 @@ private:
     skCachedProgram* m_defaultShader;
     skCachedProgram* m_fontShader;
     skCachedProgram* m_blankShader;
+    skCachedProgram* m_defaultColorShader;  // batched, colour per vertex
+    skCachedProgram* m_blankColorShader;
+    skCachedProgram* m_defaultInstanceShader;
+    skCachedProgram* m_blankInstanceShader;
     skRectangle      m_viewport;
+    skMatrix4        m_savedProjection;  // the context's view while a target is bound
+    SKint32          m_savedViewport[4];
     skPath*          m_fontPath;
+    skPath*          m_coverPath;
     skPath*          m_curPath;
     skPaint*         m_curPaint;
+    skOpenGLTexture* m_target;
     SKint32          m_fillOp;
+    SKint32          m_stencilBits;
+    SKopenGLState    m_state;
+
+    skOpenGLVertexBuffer*       m_streams[SK_STREAM_LAYOUTS];
+    skArray<SKopenGLCommand>    m_queue;
+    skArray<SKbatchList>        m_batches;
+    skPoly                      m_queueVertices;
+    skIndices                   m_queueIndices;
+    skArray<SKuint32>           m_queueColors;
+    skPoly                      m_batchVertices;
+    skIndices                   m_batchIndices;
+    skArray<SKuint32>           m_batchColors;
+    skPoly                      m_unrolled;  // indexed paths too wide for 16 bits
+    skOpenGLVertexBuffer*       m_instances;
+    skArray<SKopenGLInstance>   m_instanceData;
 
 public:
     skOpenGLRenderer();
@@ -51,8 +133,15 @@ public:
 
     void fill(skPath* pth) override;
 
+    bool fillInstanced(skPath*         pth,
+                       const skScalar* transforms,
+                       const SKuint32* colors,
+                       SKuint32        count) override;
+
     void stroke(skPath* pth) override;
 
+    void flush(void) override;
+
     void selectPaint(skPaint* paint) override;
 
     void projectBox(skScalar x1, skScalar y1, skScalar x2, skScalar y2) override;
@@ -61,14 +150,71 @@ public:
 
     void displayString(skCachedString* str) override;
 
+    void displayString(skFont* font, skPath* path) override;
+
+    skTexture* getTarget(void) override;
+
+    void bindTarget(skTexture* target) override;
+
+    void resolveTarget(skTexture* target) override;
+
+    void readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest) override;
+
+    void getStateCalls(SKuint32& issued, SKuint32& skipped) const override;
+
+    void resetStateCalls(void) override;
+
+    void invalidateState(void) override;
+
 private:
-    void doPolyFill(void) const;
+    void doPolyFill(void);
+
+    void doStencilFill(SKint32 op, SKfillRule rule);
+
+    bool hasStencil(void);
+
+    void makeCover(const skPath* pth);
+
+    void drawPath(const skCachedProgram* program, SKuint32 firstInstance, SKuint32 instanceCount);
+
+    // draws each subpath of m_curPath from the buffer, which holds it at base
+    void drawSubpaths(const skOpenGLVertexBuffer* buffer, SKuint32 base) const;
+
+    void useProgram(skCachedProgram* program);
+
+    void bindTexture(SKuint32 texture);
+
+    void setBlend(bool blend);
+
+    void setLineWidth(skScalar width);
+
+    void restoreState(void);
+
+    SKuint32 getImage(skTexture* texture);
+
+    SKuint32 getLayout(const skCachedProgram* program) const;
+
+    skOpenGLVertexBuffer* getStream(const skCachedProgram* program) const;
+
+    skCachedProgram* getColorProgram(skCachedProgram* program) const;
+
+    skCachedProgram* getInstancedProgram(skCachedProgram* program) const;
 
     void loadRect(const skRectangle& rect);
 
     void compileBuiltin(void) const;
 
     bool shouldBlend() const;
+
+    void getColors(skScalar* surface, skScalar* brush) const;
+
+    bool canBatch(void) const;
+
+    void appendBatch(void);
+
+    void sortBatches(bool reorder);
+
+    void flushBatch(void);
 };
 
 #endif  //_skOpenGLRenderer_h_
@@ -71,19 +71,26 @@ void SK_GetMinMag(const SKuint32& filter, GLint& min, GLint& mag, bool mipmap)
 }
 
 skOpenGLTexture::skOpenGLTexture() :
-    skTexture(), m_dirty(true), m_tex(0)
+    skTexture(), m_dirty(true), m_resolve(false), m_tex(0), m_fbo(0), m_stencil(0)
 {
 }
 
 skOpenGLTexture::skOpenGLTexture(SKint32 w, SKint32 h, SKpixelFormat fmt) :
     skTexture(w, h, fmt),
     m_dirty(true),
-    m_tex(0)
+    m_resolve(false),
+    m_tex(0),
+    m_fbo(0),
+    m_stencil(0)
 {
 }
 
 skOpenGLTexture::~skOpenGLTexture()
 {
+    if (m_fbo)
+        glDeleteFramebuffers(1, &m_fbo);
+    if (m_stencil)
+        glDeleteRenderbuffers(1, &m_stencil);
     glDeleteTextures(1, &m_tex);
 }
 
@@ -99,7 +106,9 @@ SKuint32 skOpenGLTexture::getImage(void)
         SK_GetFormat(m_image->getBPP(), format);
         SK_GetMinMag(m_opts.filter, min, mag, m_opts.mipmap != 0);
 
-        glGenTextures(1, &m_tex);
+        // a frame buffer may be attached to it, so keep the same name
+        if (!m_tex)
+            glGenTextures(1, &m_tex);
         glBindTexture(GL_TEXTURE_2D, m_tex);
         glEnableTexture2D();
 
@@ -125,3 +134,69 @@ SKuint32 skOpenGLTexture::getImage(void)
     }
     return m_tex;
 }
+
+SKuint32 skOpenGLTexture::getFrameBuffer(void)
+{
+    if (!m_fbo && m_image)
+    {
+        const SKuint32 tex = getImage();
+
+        glGenFramebuffers(1, &m_fbo);
+        glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+        glFramebufferTexture2D(GL_FRAMEBUFFER,
+                               GL_COLOR_ATTACHMENT0,
+                               GL_TEXTURE_2D,
+                               tex,
+                               0);
+
+        // for SK_FILL_STENCIL
+        glGenRenderbuffers(1, &m_stencil);
+        glBindRenderbuffer(GL_RENDERBUFFER, m_stencil);
+        glRenderbufferStorage(GL_RENDERBUFFER,
+                              GL_STENCIL_INDEX8,
+                              m_image->getWidth(),
+                              m_image->getHeight());
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER,
+                                  GL_STENCIL_ATTACHMENT,
+                                  GL_RENDERBUFFER,
+                                  m_stencil);
+        glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &m_fbo);
+            glDeleteRenderbuffers(1, &m_stencil);
+            m_fbo     = 0;
+            m_stencil = 0;
+        }
+    }
+    return m_fbo;
+}
+
+void skOpenGLTexture::download(void)
+{
+    if (!m_resolve || !m_fbo || !m_image)
+        return;
+
+    m_resolve = false;
+
+    GLint current = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &current);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_fbo);
+
+    // the image rows are stored bottom up, the same as GL
+    GLenum format;
+    SK_GetFormat(m_image->getBPP(), format);
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0,
+                 0,
+                 (GLsizei)m_image->getWidth(),
+                 (GLsizei)m_image->getHeight(),
+                 format,
+                 GL_UNSIGNED_BYTE,
+                 m_image->getBytes());
+
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)current);
+}
@@ -28,7 +28,10 @@ class skOpenGLTexture : public skTexture
 {
 protected:
     bool     m_dirty;
+    bool     m_resolve;
     SKuint32 m_tex;
+    SKuint32 m_fbo;
+    SKuint32 m_stencil;
 
 public:
     skOpenGLTexture();
@@ -39,6 +42,22 @@ public:
 
     SKuint32 getImage(void);
 
+    bool isDirty(void) const
+    {
+        // getImage will upload and rebind the texture
+        return m_dirty && m_image;
+    }
+
+    SKuint32 getFrameBuffer(void);
+
+    void download(void);
+
+    void invalidate(void)
+    {
+        // the frame buffer is newer than the image
+        m_resolve = true;
+    }
+
 private:
 
     void notifyImage(void) override
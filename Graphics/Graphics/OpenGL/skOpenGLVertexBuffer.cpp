@@ -19,9 +19,17 @@
   3. This notice may not be removed or altered from any source distribution.
 -------------------------------------------------------------------------------
 */
+#include <cstring>
 #include "skOpenGLVertexBuffer.h"
+#include "Utils/skMemoryUtils.h"
 #include "Window/OpenGL/skOpenGL.h"
 
+// GL 3 and ES 3 share one value for half floats, ES 2 has
+// another under OES_vertex_half_float. Neither header has both.
+#define SK_GL_HALF_FLOAT 0x140B
+#define SK_GL_HALF_FLOAT_OES 0x8D61
+
+static SKuint32 skOpenGLHalfFloat(void);
 
 static SKuint32 skOpenGLGetAttributeSize(SKuint32 type)
 {
@@ -32,6 +40,16 @@ static SKuint32 skOpenGLGetAttributeSize(SKuint32 type)
     case SK_FLOAT3_32:
     case SK_FLOAT4_32:
         return (SKuint32)sizeof(float) * (type + 1);
+    case SK_UINT1_32:
+        return (SKuint32)sizeof(SKuint32);
+    case SK_HALF2_16:
+    case SK_SHORT2_16N:
+    case SK_USHORT2_16N:
+        return (SKuint32)sizeof(SKuint16) * 2;
+    case SK_HALF4_16:
+        return (SKuint32)sizeof(SKuint16) * 4;
+    case SK_UBYTE4_8N:
+        return (SKuint32)sizeof(SKubyte) * 4;
     default:
         return 0;
     }
@@ -46,6 +64,15 @@ static SKuint32 skOpenGLGetAttributeTypeSize(SKuint32 type)
     case SK_FLOAT3_32:
     case SK_FLOAT4_32:
         return type + 1;
+    case SK_UINT1_32:
+        return 1;
+    case SK_HALF2_16:
+    case SK_SHORT2_16N:
+    case SK_USHORT2_16N:
+        return 2;
+    case SK_HALF4_16:
+    case SK_UBYTE4_8N:
+        return 4;
     default:
         return 0;
     }
@@ -60,11 +87,208 @@ static SKsize skOpenGLGetAttributeType(SKuint32 type)
     case SK_FLOAT3_32:
     case SK_FLOAT4_32:
         return GL_FLOAT;
+    case SK_UINT1_32:
+        return GL_UNSIGNED_INT;
+    case SK_HALF2_16:
+    case SK_HALF4_16:
+        return skOpenGLHalfFloat();
+    case SK_SHORT2_16N:
+        return GL_SHORT;
+    case SK_USHORT2_16N:
+        return GL_UNSIGNED_SHORT;
+    case SK_UBYTE4_8N:
+        return GL_UNSIGNED_BYTE;
     default:
         return 0;
     }
 }
 
+static GLboolean skOpenGLIsNormalized(SKuint32 type)
+{
+    return type == SK_SHORT2_16N ||
+           type == SK_USHORT2_16N ||
+           type == SK_UBYTE4_8N;
+}
+
+static SKuint16 skOpenGLToHalf(float value)
+{
+    SKuint32 bits;
+    skMemcpy(&bits, &value, sizeof(SKuint32));
+
+    const SKuint16 sign = (SKuint16)((bits >> 16) & 0x8000);
+    const SKint32  exp  = (SKint32)((bits >> 23) & 0xFF) - 127 + 15;
+    const SKuint32 man  = bits & 0x7FFFFF;
+
+    if (exp <= 0)  // too small, flushed to zero
+        return sign;
+    if (exp >= 31)  // too large or NaN, kept as infinity
+        return (SKuint16)(sign | 0x7C00);
+
+    // round to the nearest representable value
+    SKuint32 half = ((SKuint32)exp << 10) | (man >> 13);
+    if (man & 0x1000)
+        ++half;
+    return (SKuint16)(sign | (half > 0x7C00 ? 0x7C00 : half));
+}
+
+static void skOpenGLPackAttribute(SKubyte* dst, SKuint32 type, const float* src)
+{
+    switch (type)
+    {
+    case SK_FLOAT1_32:
+    case SK_FLOAT2_32:
+    case SK_FLOAT3_32:
+    case SK_FLOAT4_32:
+        skMemcpy(dst, src, sizeof(float) * (type + 1));
+        break;
+    case SK_UINT1_32:
+    {
+        const SKuint32 v = (SKuint32)src[0];
+        skMemcpy(dst, &v, sizeof(SKuint32));
+        break;
+    }
+    case SK_HALF2_16:
+    case SK_HALF4_16:
+    {
+        SKuint16       v[4];
+        const SKuint32 nr = type == SK_HALF2_16 ? 2 : 4;
+        for (SKuint32 i = 0; i < nr; ++i)
+            v[i] = skOpenGLToHalf(src[i]);
+        skMemcpy(dst, v, sizeof(SKuint16) * nr);
+        break;
+    }
+    case SK_SHORT2_16N:
+    {
+        SKint16 v[2];
+        for (SKuint32 i = 0; i < 2; ++i)
+            v[i] = (SKint16)(skClamp(src[i], -1.f, 1.f) * 32767.f);
+        skMemcpy(dst, v, sizeof(v));
+        break;
+    }
+    case SK_USHORT2_16N:
+    {
+        SKuint16 v[2];
+        for (SKuint32 i = 0; i < 2; ++i)
+            v[i] = (SKuint16)(skClamp(src[i], 0.f, 1.f) * 65535.f + .5f);
+        skMemcpy(dst, v, sizeof(v));
+        break;
+    }
+    case SK_UBYTE4_8N:
+    {
+        for (SKuint32 i = 0; i < 4; ++i)
+            dst[i] = (SKubyte)(skClamp(src[i], 0.f, 1.f) * 255.f + .5f);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+// The GL version is read once per thread, as each thread
+// drives its own context, and again after invalidate. The
+// bound vertex array is not tracked at all, since other code
+// that shares the context can change it at any time.
+static thread_local SKint32  g_version   = -1;
+static thread_local bool     g_embedded  = false;
+static thread_local SKint32  g_index32   = -1;
+static thread_local SKuint32 g_halfFloat = SK_NPOS32;
+
+// Returns major * 10 + minor, or zero when there is no context.
+static SKint32 skOpenGLGetVersion(void)
+{
+    if (g_version == -1)
+    {
+        const char* version = (const char*)glGetString(GL_VERSION);
+        if (!version)
+            return 0;  // no context yet, ask again later
+
+        // "3.3.0 ..." or "OpenGL ES 3.0 ..."
+        g_embedded = version[0] == 'O';
+        while (*version && (*version < '0' || *version > '9'))
+            ++version;
+
+        SKint32 major = 0;
+        while (*version >= '0' && *version <= '9')
+            major = major * 10 + (*version++ - '0');
+
+        SKint32 minor = 0;
+        if (*version == '.' && version[1] >= '0' && version[1] <= '9')
+            minor = version[1] - '0';
+
+        g_version = major * 10 + minor;
+    }
+    return g_version;
+}
+
+static bool skOpenGLHasExtension(const char* name)
+{
+    const char* extensions = (const char*)glGetString(GL_EXTENSIONS);
+    return extensions && strstr(extensions, name);
+}
+
+// Returns the type of a half float attribute in the current
+// context, or zero when it cannot read them.
+static SKuint32 skOpenGLHalfFloat(void)
+{
+    if (g_halfFloat == SK_NPOS32)
+    {
+        const SKint32 version = skOpenGLGetVersion();
+        if (!version)
+            return 0;  // no context yet, ask again later
+
+        if (version >= 30)
+            g_halfFloat = SK_GL_HALF_FLOAT;
+        else if (g_embedded)
+            g_halfFloat = skOpenGLHasExtension("GL_OES_vertex_half_float") ? SK_GL_HALF_FLOAT_OES : 0;
+        else
+            g_halfFloat = skOpenGLHasExtension("GL_ARB_half_float_vertex") ? SK_GL_HALF_FLOAT : 0;
+    }
+    return g_halfFloat;
+}
+
+// vertex array objects need GL 3 or ES 3 (WebGL 2)
+static bool skOpenGLHasVertexArrays(void)
+{
+#ifdef GL_VERTEX_ARRAY_BINDING
+    return skOpenGLGetVersion() >= 30;
+#else
+    return false;
+#endif
+}
+
+bool skOpenGLVertexBuffer::hasInstancing(void)
+{
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+    // core in GL 3.3 and ES 3 (WebGL 2)
+    const SKint32 version = skOpenGLGetVersion();
+    return version >= (g_embedded ? 30 : 33);
+#else
+    return false;
+#endif
+}
+
+bool skOpenGLVertexBuffer::hasIndex32(void)
+{
+    if (g_index32 == -1)
+    {
+        const SKint32 version = skOpenGLGetVersion();
+        if (!version)
+            return false;  // no context yet, ask again later
+
+        g_index32 = 1;
+        if (g_embedded && version < 30)
+            g_index32 = skOpenGLHasExtension("GL_OES_element_index_uint") ? 1 : 0;
+    }
+    return g_index32 != 0;
+}
+
+void skOpenGLVertexBuffer::invalidate(void)
+{
+    g_version   = -1;
+    g_index32   = -1;
+    g_halfFloat = SK_NPOS32;
+}
+
 static SKsize skOpenGLGetBufferMode(SKsize type)
 {
     switch (type)
@@ -99,16 +323,87 @@ skOpenGLVertexBuffer::skOpenGLVertexBuffer()
     m_mode      = 0;
     m_stride    = 0;
     m_totalFill = 0;
+    m_cursor    = 0;
+    m_discard   = false;
+    m_native    = false;
+
+    m_indexId      = 0;
+    m_indexSize    = 0;
+    m_indexCount   = 0;
+    m_indexType    = SK_INDEX_16;
+    m_indexCursor  = 0;
+    m_indexDiscard = false;
+
+    m_vao      = 0;
+    m_vaoFirst = SK_NPOS32;
+
+    m_instances     = nullptr;
+    m_firstInstance = 0;
+    m_instanceCount = 0;
 }
 
 skOpenGLVertexBuffer::~skOpenGLVertexBuffer()
 {
     if (m_bufId)
         glDeleteBuffers(1, &m_bufId);
+    if (m_indexId)
+        glDeleteBuffers(1, &m_indexId);
+
+#ifdef GL_VERTEX_ARRAY_BINDING
+    if (m_vao)
+        glDeleteVertexArrays(1, &m_vao);
+#endif
+}
+
+bool skOpenGLVertexBuffer::bindVertexArray(void) const
+{
+#ifdef GL_VERTEX_ARRAY_BINDING
+    if (!skOpenGLHasVertexArrays())
+        return false;
+
+    if (!m_vao)
+    {
+        glGenVertexArrays(1, &m_vao);
+        glBindVertexArray(m_vao);
+        m_vaoFirst = SK_NPOS32;
+
+        if (m_indexId)
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexId);
+    }
+    else
+        glBindVertexArray(m_vao);
+    return true;
+#else
+    return false;
+#endif
+}
+
+void skOpenGLVertexBuffer::unbindVertexArray(void)
+{
+#ifdef GL_VERTEX_ARRAY_BINDING
+    if (skOpenGLHasVertexArrays())
+        glBindVertexArray(0);
+#endif
+}
+
+bool skOpenGLVertexBuffer::bindIndexBuffer(void)
+{
+    if (!m_indexId)
+        glGenBuffers(1, &m_indexId);
+
+    // the element binding belongs to the vertex array, so
+    // it is never bound while some other array is current
+    const bool vao = bindVertexArray();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexId);
+    return vao;
 }
 
 SKsize skOpenGLVertexBuffer::addElement(SKuint32 name, SKuint32 type)
 {
+    // ES 2 and GL 2 only read half floats with an extension
+    if ((type == SK_HALF2_16 || type == SK_HALF4_16) && !skOpenGLHalfFloat())
+        return 0;
+
     if (skOpenGLGetAttributeSize(type) != 0)
     {
         skVertexElement t;
@@ -117,6 +412,16 @@ SKsize skOpenGLVertexBuffer::addElement(SKuint32 name, SKuint32 type)
 
         m_elements.push_back(t);
         m_stride += skOpenGLGetAttributeSize(type);
+        m_vaoFirst = SK_NPOS32;
+
+        // float positions followed by float coordinates is the
+        // layout of skVertex, which can be copied as is
+        m_native = sizeof(skScalar) == sizeof(float) &&
+                   m_elements.size() == 2 &&
+                   m_elements[0].name == SK_ATTR_POSITION &&
+                   m_elements[0].type == SK_FLOAT2_32 &&
+                   m_elements[1].name == SK_ATTR_TEXTURE0 &&
+                   m_elements[1].type == SK_FLOAT2_32;
 
         return m_stride;
     }
@@ -132,40 +437,390 @@ void skOpenGLVertexBuffer::write(const void* ptr, const SKuint32& sizeInBytes, c
         glGenBuffers(1, &m_bufId);
     glBindBuffer(GL_ARRAY_BUFFER, m_bufId);
 
-    m_totalFill = 0;
-    m_size      = sizeInBytes;
-    m_mode      = mode;
+    m_size = sizeInBytes;
+    m_mode = mode;
 
     glBufferData(GL_ARRAY_BUFFER, m_size, ptr, (GLenum)skOpenGLGetBufferMode(m_mode));
 
-    const skArray<skVertexElement>::PointerType elements = m_elements.ptr();
+    // the attributes are pointed at the buffer when it is drawn
+    m_totalFill = m_stride != 0 ? m_size / m_stride : 0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void skOpenGLVertexBuffer::writeVertices(const skVertex* ptr, const SKuint32& count, const SKint32& mode)
+{
+    if (!ptr || !count)
+        return;
+
+    write(packVertices(ptr, count), count * m_stride, mode);
+}
+
+const void* skOpenGLVertexBuffer::packVertices(const skVertex* ptr, SKuint32 count, const SKuint32* colors)
+{
+    if (m_native)
+        return ptr;
+
+    m_packedVertices.resize(count * m_stride);
 
-    SKuint32       i    = 0;
+    SKubyte*       dst  = m_packedVertices.ptr();
     const SKuint32 size = m_elements.size();
 
+    for (SKuint32 v = 0; v < count; ++v)
+    {
+        const skVertex& vtx = ptr[v];
+
+        for (SKuint32 i = 0; i < size; ++i)
+        {
+            const skVertexElement& ele = m_elements[i];
+
+            float src[4] = {0, 0, 0, 1};
+            if (ele.name == SK_ATTR_POSITION)
+            {
+                src[0] = (float)vtx.x;
+                src[1] = (float)vtx.y;
+            }
+            else if (ele.name == SK_ATTR_TEXTURE0)
+            {
+                src[0] = (float)vtx.u;
+                src[1] = (float)vtx.v;
+            }
+            else if (ele.name == SK_ATTR_COLORS)
+            {
+                if (colors && ele.type == SK_UBYTE4_8N)
+                {
+                    skMemcpy(dst, &colors[v], sizeof(SKuint32));
+                    dst += sizeof(SKuint32);
+                    continue;
+                }
+
+                // white unless given
+                src[0] = src[1] = src[2] = 1;
+                if (colors)
+                {
+                    const SKubyte* rgba = (const SKubyte*)&colors[v];
+                    for (SKuint32 c = 0; c < 4; ++c)
+                        src[c] = (float)rgba[c] / 255.f;
+                }
+            }
+
+            skOpenGLPackAttribute(dst, ele.type, src);
+            dst += skOpenGLGetAttributeSize(ele.type);
+        }
+    }
+    return m_packedVertices.ptr();
+}
+
+void skOpenGLVertexBuffer::writeIndices(const SKuint32* ptr, const SKuint32& count, const SKint32& mode)
+{
+    m_indexCount = 0;
+    if (!ptr || !count)
+        return;
+
+    m_indexType = packIndices(ptr, count);
+
+    const bool vao = bindIndexBuffer();
+
+    m_indexCount = count;
+    m_indexSize  = m_packed.size();
+
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexSize, m_packed.ptr(), (GLenum)skOpenGLGetBufferMode(mode));
+    if (!vao)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+SKint32 skOpenGLVertexBuffer::packIndices(const SKuint32* ptr, SKuint32 count)
+{
+    SKuint32 max = 0;
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        if (ptr[i] > max)
+            max = ptr[i];
+    }
+
+    // The renderer keeps anything wider than this away
+    // when hasIndex32 is false, so it only saves space.
+    if (max <= 0xFFFF)
+    {
+        m_packed.resize(count * sizeof(SKuint16));
+
+        SKuint16* dst = (SKuint16*)m_packed.ptr();
+        for (SKuint32 i = 0; i < count; ++i)
+            dst[i] = (SKuint16)ptr[i];
+        return SK_INDEX_16;
+    }
+
+    m_packed.resize(count * sizeof(SKuint32));
+    skMemcpy(m_packed.ptr(), ptr, count * sizeof(SKuint32));
+    return SK_INDEX_32;
+}
+
+void skOpenGLVertexBuffer::bindElements(SKuint32 firstVertex, bool enable) const
+{
+    SKuint32       i      = 0;
+    SKuint32       offset = firstVertex * m_stride;
+    SKuint32       used   = 0;
+    const SKuint32 size   = m_elements.size();
+
     while (i < size)
     {
-        skVertexElement& ele = elements[i++];
+        const skVertexElement& ele = m_elements[i++];
         glVertexAttribPointer(ele.name,
                               skOpenGLGetAttributeTypeSize(ele.type),
                               (GLenum)skOpenGLGetAttributeType(ele.type),
-                              GL_FALSE,
+                              skOpenGLIsNormalized(ele.type),
                               m_stride,
-                              (GLvoid*)(SKsize)m_totalFill);
+                              (GLvoid*)(SKsize)offset);
 
-        glEnableVertexAttribArray(ele.name);
-        m_totalFill += skOpenGLGetAttributeSize(ele.type);
+        if (enable)
+            glEnableVertexAttribArray(ele.name);
+        offset += skOpenGLGetAttributeSize(ele.type);
+        used |= 1 << ele.name;
     }
 
-    if (m_totalFill != 0)
-        m_totalFill = m_size / m_totalFill;
+    if (!enable)
+        return;
+
+    // a shorter layout must not leave arrays from the
+    // last buffer enabled, they would read past its end
+    for (SKuint32 name = SK_ATTR_POSITION; name <= SK_ATTR_COLORS; ++name)
+    {
+        if (!(used & (1 << name)))
+            glDisableVertexAttribArray(name);
+    }
+}
+
+bool skOpenGLVertexBuffer::bindAttributes(SKuint32 firstVertex) const
+{
+    const bool vao = bindVertexArray();
+
+    // the vertex array keeps the layout from the last draw
+    if (vao && m_vaoFirst == firstVertex)
+        return true;
 
+    glBindBuffer(GL_ARRAY_BUFFER, m_bufId);
+    bindElements(firstVertex, !vao || m_vaoFirst == SK_NPOS32);
+
+    if (vao)
+    {
+        m_vaoFirst = firstVertex;
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+    return vao;
+}
+
+void skOpenGLVertexBuffer::setInstances(const skOpenGLVertexBuffer* instances,
+                                        SKuint32                    firstInstance,
+                                        SKuint32                    instanceCount)
+{
+    m_instances     = instanceCount > 0 && hasInstancing() ? instances : nullptr;
+    m_firstInstance = firstInstance;
+    m_instanceCount = instanceCount;
+}
+
+void skOpenGLVertexBuffer::bindInstanceElements(SKuint32 firstInstance, bool enable) const
+{
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+    SKuint32 offset = firstInstance * m_stride;
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_bufId);
+    for (SKuint32 i = 0; i < m_elements.size(); ++i)
+    {
+        const skVertexElement& ele = m_elements[i];
+        if (enable)
+        {
+            glVertexAttribPointer(ele.name,
+                                  skOpenGLGetAttributeTypeSize(ele.type),
+                                  (GLenum)skOpenGLGetAttributeType(ele.type),
+                                  skOpenGLIsNormalized(ele.type),
+                                  m_stride,
+                                  (GLvoid*)(SKsize)offset);
+            glEnableVertexAttribArray(ele.name);
+            glVertexAttribDivisor(ele.name, 1);
+        }
+        else
+        {
+            // leave the array as the per vertex draws expect it
+            glVertexAttribDivisor(ele.name, 0);
+            glDisableVertexAttribArray(ele.name);
+        }
+        offset += skOpenGLGetAttributeSize(ele.type);
+    }
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+#endif
+}
+
+void skOpenGLVertexBuffer::drawArrays(SKuint32 op, SKuint32 first, SKuint32 count) const
+{
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+    if (m_instances)
+    {
+        m_instances->bindInstanceElements(m_firstInstance, true);
+        glDrawArraysInstanced(op, (GLint)first, (GLsizei)count, (GLsizei)m_instanceCount);
+        m_instances->bindInstanceElements(m_firstInstance, false);
+        return;
+    }
+#endif
+    glDrawArrays(op, (GLint)first, (GLsizei)count);
+}
+
+void skOpenGLVertexBuffer::drawElements(SKuint32 op,
+                                        SKuint32 offset,
+                                        SKuint32 count,
+                                        SKint32  type,
+                                        bool     vao) const
+{
+    if (!vao)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexId);
+
+    const GLenum indexType = type == SK_INDEX_16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+#ifdef GL_VERTEX_ATTRIB_ARRAY_DIVISOR
+    if (m_instances)
+    {
+        m_instances->bindInstanceElements(m_firstInstance, true);
+        glDrawElementsInstanced(op,
+                                (GLsizei)count,
+                                indexType,
+                                (GLvoid*)(SKsize)offset,
+                                (GLsizei)m_instanceCount);
+        m_instances->bindInstanceElements(m_firstInstance, false);
+    }
+    else
+#endif
+        glDrawElements(op, (GLsizei)count, indexType, (GLvoid*)(SKsize)offset);
+
+    if (!vao)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void skOpenGLVertexBuffer::fill(SKuint32 op) const
 {
+    // the attribute pointers belong to the last buffer drawn,
+    // which is not this one when the data is reused
+    const bool vao = bindAttributes(0);
+
+    if (m_indexCount)
+        drawElements(op, 0, m_indexCount, m_indexType, vao);
+    else
+        drawArrays(op, 0, m_totalFill);
+
+    if (!vao)
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void skOpenGLVertexBuffer::fill(SKuint32 op, SKuint32 first, SKuint32 count) const
+{
+    if (first + count > m_totalFill)
+        return;
+
+    const bool vao = bindAttributes(0);
+
+    drawArrays(op, first, count);
+
+    if (!vao)
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+SKuint32 skOpenGLVertexBuffer::stream(const void* ptr, SKuint32 sizeInBytes)
+{
+    if (!ptr || !sizeInBytes || m_stride == 0)
+        return SK_NPOS32;
+
+    if (!m_bufId)
+        glGenBuffers(1, &m_bufId);
     glBindBuffer(GL_ARRAY_BUFFER, m_bufId);
-    glDrawArrays(op, 0, m_totalFill);
+
+    bool orphan = m_discard || m_mode != SK_STREAM_DRAW;
+    if (m_size < sizeInBytes || m_size < SK_STREAM_BUFFER_SIZE)
+    {
+        m_size = SK_STREAM_BUFFER_SIZE;
+        while (m_size < sizeInBytes)
+            m_size <<= 1;
+        orphan = true;
+    }
+
+    // keep every copy on a vertex boundary
+    SKuint32 cursor = (m_cursor + m_stride - 1) / m_stride * m_stride;
+
+    if (orphan || cursor + sizeInBytes > m_size)
+    {
+        // Hands the old store back to the driver, which keeps it
+        // alive until the draws that still read from it are done.
+        glBufferData(GL_ARRAY_BUFFER, m_size, nullptr, GL_STREAM_DRAW);
+        cursor = 0;
+    }
+
+    glBufferSubData(GL_ARRAY_BUFFER, cursor, sizeInBytes, ptr);
+
+    m_mode      = SK_STREAM_DRAW;
+    m_discard   = false;
+    m_cursor    = cursor + sizeInBytes;
+    m_totalFill = m_size / m_stride;
+
     glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return cursor / m_stride;
+}
+
+SKuint32 skOpenGLVertexBuffer::streamVertices(const skVertex* ptr, SKuint32 count, const SKuint32* colors)
+{
+    if (!ptr || !count)
+        return SK_NPOS32;
+    return stream(packVertices(ptr, count, colors), count * m_stride);
+}
+
+SKuint32 skOpenGLVertexBuffer::streamIndices(const SKuint32* ptr, SKuint32 count, SKint32& type)
+{
+    if (!ptr || !count)
+        return SK_NPOS32;
+
+    type = packIndices(ptr, count);
+
+    const SKuint32 sizeInBytes = m_packed.size();
+
+    const bool vao = bindIndexBuffer();
+
+    bool orphan = m_indexDiscard;
+    if (m_indexSize < sizeInBytes || m_indexSize < SK_STREAM_INDEX_SIZE)
+    {
+        m_indexSize = SK_STREAM_INDEX_SIZE;
+        while (m_indexSize < sizeInBytes)
+            m_indexSize <<= 1;
+        orphan = true;
+    }
+
+    // both index sizes read from a four byte boundary
+    SKuint32 cursor = (m_indexCursor + 3) & ~3u;
+
+    if (orphan || cursor + sizeInBytes > m_indexSize)
+    {
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indexSize, nullptr, GL_STREAM_DRAW);
+        cursor = 0;
+    }
+
+    glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, cursor, sizeInBytes, m_packed.ptr());
+
+    m_indexDiscard = false;
+    m_indexCursor  = cursor + sizeInBytes;
+
+    if (!vao)
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    return cursor;
+}
+
+void skOpenGLVertexBuffer::fillElements(SKuint32 op,
+                                        SKuint32 firstVertex,
+                                        SKuint32 offset,
+                                        SKuint32 count,
+                                        SKint32  type) const
+{
+    if (!m_indexId || offset == SK_NPOS32 || firstVertex >= m_totalFill)
+        return;
+
+    const bool vao = bindAttributes(firstVertex);
+
+    drawElements(op, offset, count, type, vao);
+
+    if (!vao)
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
@@ -25,6 +25,9 @@
 #include "Utils/skArray.h"
 #include "skVertexBuffer.h"
 
+#define SK_STREAM_BUFFER_SIZE 0x400000
+#define SK_STREAM_INDEX_SIZE 0x100000
+
 typedef struct skVertexElement
 {
     SKuint32 name, type;
@@ -38,8 +41,26 @@ private:
     SKuint32 m_totalFill;
     SKuint32 m_size;
     SKuint32 m_mode;
+    SKuint32 m_cursor;
+    bool     m_discard;
+    SKuint32 m_indexId;
+    SKuint32 m_indexSize;
+    SKuint32 m_indexCount;
+    SKint32  m_indexType;
+    SKuint32 m_indexCursor;
+    bool     m_indexDiscard;
+    bool     m_native;
+
+    mutable SKuint32 m_vao;
+    mutable SKuint32 m_vaoFirst;  // the vertex the array points at
+
+    const skOpenGLVertexBuffer* m_instances;
+    SKuint32                    m_firstInstance;
+    SKuint32                    m_instanceCount;
 
     skArray<skVertexElement> m_elements;
+    skArray<SKubyte>         m_packed;
+    skArray<SKubyte>         m_packedVertices;
 
 public:
     skOpenGLVertexBuffer();
@@ -64,7 +85,88 @@ public:
 
     void write(const void* ptr, const SKuint32& sizeInBytes, const SKint32& mode) override;
 
+    void writeVertices(const skVertex* ptr, const SKuint32& count, const SKint32& mode) override;
+
+    void writeIndices(const SKuint32* ptr, const SKuint32& count, const SKint32& mode) override;
+
     void fill(SKuint32 op) const override;
+
+    void fill(SKuint32 op, SKuint32 first, SKuint32 count) const;
+
+    // Appends to one large buffer rather than reallocating it on
+    // every write. Returns the first vertex of the copy, for use
+    // with the ranged fill.
+    SKuint32 stream(const void* ptr, SKuint32 sizeInBytes);
+
+    // Streams the vertices converted to the element layout.
+    // SK_ATTR_COLORS reads packed r, g, b, a bytes from colors.
+    SKuint32 streamVertices(const skVertex* ptr, SKuint32 count, const SKuint32* colors = nullptr);
+
+    SKuint32 getStride(void) const
+    {
+        return m_stride;
+    }
+
+    // Appends indices to the element stream, as 16 bit values when
+    // they fit. Returns the byte offset of the copy and its type.
+    SKuint32 streamIndices(const SKuint32* ptr, SKuint32 count, SKint32& type);
+
+    // Draws count streamed indices. They are relative to firstVertex,
+    // so 16 bit indices work anywhere in the stream.
+    void fillElements(SKuint32 op,
+                      SKuint32 firstVertex,
+                      SKuint32 offset,
+                      SKuint32 count,
+                      SKint32  type) const;
+
+    // Makes the fills draw instanceCount copies, reading the elements
+    // of instances once per copy from firstInstance on. A count of
+    // zero goes back to single draws.
+    void setInstances(const skOpenGLVertexBuffer* instances,
+                      SKuint32                    firstInstance,
+                      SKuint32                    instanceCount);
+
+    // true when GL has instanced arrays
+    static bool hasInstancing(void);
+
+    // true when GL draws from 32 bit indices, which
+    // ES 2 (WebGL 1) only does with OES_element_index_uint
+    static bool hasIndex32(void);
+
+    // Leaves no vertex array bound, for anything else
+    // that draws into the same context.
+    static void unbindVertexArray(void);
+
+    // the version and extensions are read again on the next query
+    static void invalidate(void);
+
+    // the next stream call starts again in a fresh store
+    void discard(void)
+    {
+        m_discard      = true;
+        m_indexDiscard = true;
+    }
+
+private:
+    void bindElements(SKuint32 firstVertex, bool enable) const;
+
+    // Binds the vertex array when there is one, pointing it at
+    // firstVertex. Returns false when GL has no vertex arrays.
+    bool bindVertexArray(void) const;
+
+    bool bindAttributes(SKuint32 firstVertex) const;
+
+    bool bindIndexBuffer(void);
+
+    void bindInstanceElements(SKuint32 firstInstance, bool enable) const;
+
+    void drawArrays(SKuint32 op, SKuint32 first, SKuint32 count) const;
+
+    void drawElements(SKuint32 op, SKuint32 offset, SKuint32 count, SKint32 type, bool vao) const;
+
+    const void* packVertices(const skVertex* ptr, SKuint32 count, const SKuint32* colors = nullptr);
+
+    SKint32 packIndices(const SKuint32* ptr, SKuint32 count);
 };
 
 #endif  //_skOpenGLVertexBuffer_h_
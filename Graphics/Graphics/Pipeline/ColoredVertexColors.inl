@@ -0,0 +1,43 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _ColoredVertexColors_
+#define _ColoredVertexColors_
+
+#include "Graphics/skGraphicsConfig.h"
+// clang-format off
+
+SKShader(ColoredVertexColors,
+attribute vec2 position;
+attribute vec4 color;
+uniform mat4   viewproj;
+uniform float  zorder;
+varying vec4   surface;
+void main(void)
+{
+    gl_Position = viewproj * vec4(position.x, position.y, zorder, 1);
+    surface     = color;
+}
+);
+
+// clang-format on
+
+#endif  //_ColoredVertexColors_
\ No newline at end of file
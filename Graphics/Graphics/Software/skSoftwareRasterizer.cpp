@@ -0,0 +1,834 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Software/skSoftwareRasterizer.h"
+#include <cmath>
+
+#define SK_SOFTWARE_AA_STRIP 32
+
+static SKubyte skSoftwareByte(skScalar v)
+{
+    return (SKubyte)(skClamp<skScalar>(v, 0, 1) * skScalar(255) + skScalar(0.5));
+}
+
+static SKint32 skSoftwareCeil(skScalar v)
+{
+    return (SKint32)ceil((double)v);
+}
+
+static SKint32 skSoftwareFloor(skScalar v)
+{
+    return (SKint32)floor((double)v);
+}
+
+static skScalar skSoftwareEdgeFunc(const skVertex& a, const skVertex& b, skScalar px, skScalar py)
+{
+    return (b.x - a.x) * (py - a.y) - (b.y - a.y) * (px - a.x);
+}
+
+static bool skSoftwareTopLeft(const skVertex& a, const skVertex& b)
+{
+    const skScalar dy = b.y - a.y;
+    return dy < 0 || (skIsZero(dy) && b.x - a.x > 0);
+}
+
+skSoftwareShader::skSoftwareShader() :
+    m_mode(SK_BM_REPLACE),
+    m_surface(0, 0, 0, 1),
+    m_brush(0, 0, 0, 1),
+    m_pattern(nullptr),
+    m_font(false),
+    m_solid({0, 0, 0, 255})
+{
+}
+
+void skSoftwareShader::setPattern(const skSoftwareSurface* pattern)
+{
+    m_pattern = pattern && pattern->isValid() ? pattern : nullptr;
+}
+
+void skSoftwareShader::setup(SKint32        mode,
+                             const skColor& surface,
+                             const skColor& brush,
+                             bool           font)
+{
+    m_mode    = mode;
+    m_surface = surface;
+    m_brush   = brush;
+    m_pattern = nullptr;
+    m_font    = font;
+
+    skScalar r, g, b;
+    switch (m_mode)
+    {
+    case SK_BM_ADD:
+        r = m_brush.r + m_surface.r;
+        g = m_brush.g + m_surface.g;
+        b = m_brush.b + m_surface.b;
+        break;
+    case SK_BM_MODULATE:
+        r = m_brush.r * m_surface.r;
+        g = m_brush.g * m_surface.g;
+        b = m_brush.b * m_surface.b;
+        break;
+    case SK_BM_SUBTRACT:
+        r = m_surface.r - m_brush.r;
+        g = m_surface.g - m_brush.g;
+        b = m_surface.b - m_brush.b;
+        break;
+    case SK_BM_DIVIDE:
+        r = 1 - m_surface.r * m_brush.r;
+        g = 1 - m_surface.g * m_brush.g;
+        b = 1 - m_surface.b * m_brush.b;
+        break;
+    case SK_BM_REPLACE:
+    default:
+        r = m_surface.r;
+        g = m_surface.g;
+        b = m_surface.b;
+        break;
+    }
+
+    m_solid.r = skSoftwareByte(r);
+    m_solid.g = skSoftwareByte(g);
+    m_solid.b = skSoftwareByte(b);
+    m_solid.a = skSoftwareByte(m_surface.a);
+}
+
+void skSoftwareShader::shade(skScalar u, skScalar v, SKcolor4b& col) const
+{
+    if (!m_pattern)
+    {
+        col = m_solid;
+        return;
+    }
+
+    SKcolor4b tex;
+    m_pattern->sample(u, v, tex);
+
+    if (m_font)
+    {
+        const skScalar a = skScalar(tex.a) * skColorUtils::i255;
+        if (a >= skScalar(0.375) && a <= skScalar(0.7))
+        {
+            col.r = skSoftwareByte(skScalar(1.1) * m_surface.r);
+            col.g = skSoftwareByte(skScalar(1.1) * m_surface.g);
+            col.b = skSoftwareByte(skScalar(1.1) * m_surface.b);
+            col.a = tex.a;
+        }
+        else if (a > skScalar(0.7))
+            col = m_solid;
+        else
+            col = {0, 0, 0, 0};
+        return;
+    }
+
+    if (m_mode == SK_BM_REPLACE)
+    {
+        col = tex;
+        return;
+    }
+
+    const skScalar tr = skScalar(tex.r) * skColorUtils::i255;
+    const skScalar tg = skScalar(tex.g) * skColorUtils::i255;
+    const skScalar tb = skScalar(tex.b) * skColorUtils::i255;
+    const skScalar ta = skScalar(tex.a) * skColorUtils::i255;
+
+    skScalar r, g, b;
+    switch (m_mode)
+    {
+    case SK_BM_ADD:
+        r = tr + m_surface.r;
+        g = tg + m_surface.g;
+        b = tb + m_surface.b;
+        break;
+    case SK_BM_MODULATE:
+        r = tr * m_surface.r;
+        g = tg * m_surface.g;
+        b = tb * m_surface.b;
+        break;
+    case SK_BM_SUBTRACT:
+        r = m_surface.r - tr;
+        g = m_surface.g - tg;
+        b = m_surface.b - tb;
+        break;
+    default:
+        r = 1 - m_surface.r * tr;
+        g = 1 - m_surface.g * tg;
+        b = 1 - m_surface.b * tb;
+        break;
+    }
+
+    col.r = skSoftwareByte(r);
+    col.g = skSoftwareByte(g);
+    col.b = skSoftwareByte(b);
+    col.a = skSoftwareByte(ta * m_surface.a);
+}
+
+bool skSoftwareRasterizer::makeGradient(const skVertex*     pts,
+                                        SKuint32            count,
+                                        SKsoftwareGradient& grad)
+{
+    // The texture coordinates of a filled path are an affine
+    // function of its position, so any non degenerate triangle
+    // taken from the outline is enough to recover the mapping.
+    const skVertex& a = pts[0];
+    for (SKuint32 i = 1; i + 1 < count; ++i)
+    {
+        const skVertex& b = pts[i];
+        const skVertex& c = pts[i + 1];
+
+        const skScalar det = (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+        if (skAbs(det) < skScalar(1e-4))
+            continue;
+
+        const skScalar id = 1 / det;
+
+        grad.x0   = a.x;
+        grad.y0   = a.y;
+        grad.u0   = a.u;
+        grad.v0   = a.v;
+        grad.dudx = ((b.u - a.u) * (c.y - a.y) - (c.u - a.u) * (b.y - a.y)) * id;
+        grad.dudy = ((c.u - a.u) * (b.x - a.x) - (b.u - a.u) * (c.x - a.x)) * id;
+        grad.dvdx = ((b.v - a.v) * (c.y - a.y) - (c.v - a.v) * (b.y - a.y)) * id;
+        grad.dvdy = ((c.v - a.v) * (b.x - a.x) - (b.v - a.v) * (c.x - a.x)) * id;
+        return true;
+    }
+    return false;
+}
+
+void skSoftwareRasterizer::fillSpan(SKint32                   y,
+                                    skScalar                  xa,
+                                    skScalar                  xb,
+                                    const SKsoftwareClip&     clip,
+                                    const skSoftwareSurface&  dst,
+                                    const skSoftwareShader&   shader,
+                                    const SKsoftwareGradient& grad) const
+{
+    // covers the pixels whose centers are in [xa, xb)
+    SKint32 x1 = skSoftwareCeil(xa - skScalar(0.5));
+    SKint32 x2 = skSoftwareCeil(xb - skScalar(0.5));
+
+    x1 = skMax<SKint32>(x1, clip.x1);
+    x2 = skMin<SKint32>(x2, clip.x2);
+    if (x1 >= x2)
+        return;
+
+    if (shader.isSolid())
+    {
+        dst.blendSpan(y, x1, x2, shader.getSolid());
+        return;
+    }
+
+    const skScalar py = skScalar(y) + skScalar(0.5) - grad.y0;
+
+    SKcolor4b col;
+    for (SKint32 x = x1; x < x2; ++x)
+    {
+        const skScalar px = skScalar(x) + skScalar(0.5) - grad.x0;
+
+        shader.shade(grad.u0 + grad.dudx * px + grad.dudy * py,
+                     grad.v0 + grad.dvdx * px + grad.dvdy * py,
+                     col);
+        dst.blendPixel(x, y, col);
+    }
+}
+
+void skSoftwareRasterizer::fillPolygon(const skVertex*          pts,
+                                       SKuint32                 count,
+                                       SKfillRule               rule,
+                                       const SKsoftwareClip&    clip,
+                                       const skSoftwareSurface& dst,
+                                       const skSoftwareShader&  shader)
+{
+    if (!pts || count < 3)
+        return;
+
+    SKsoftwareGradient grad = {};
+    if (!shader.isSolid() && !makeGradient(pts, count, grad))
+        return;
+
+    m_edges.resizeFast(0);
+
+    skScalar yMin = pts[0].y, yMax = pts[0].y;
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        // the outline is implicitly closed
+        const skVertex& a = pts[i];
+        const skVertex& b = pts[(i + 1) % count];
+
+        yMin = skMin(yMin, a.y);
+        yMax = skMax(yMax, a.y);
+
+        if (skEqT(a.y, b.y, skScalar(1e-6)))
+            continue;
+
+        SKsoftwareEdge edge;
+        if (a.y < b.y)
+        {
+            edge.x0  = a.x;
+            edge.y0  = a.y;
+            edge.y1  = b.y;
+            edge.dir = 1;
+        }
+        else
+        {
+            edge.x0  = b.x;
+            edge.y0  = b.y;
+            edge.y1  = a.y;
+            edge.dir = -1;
+        }
+        edge.dxdy = (b.x - a.x) / (b.y - a.y);
+        m_edges.push_back(edge);
+    }
+
+    if (m_edges.empty())
+        return;
+
+    SKint32 y1 = skSoftwareCeil(yMin - skScalar(0.5));
+    SKint32 y2 = skSoftwareCeil(yMax - skScalar(0.5));
+
+    y1 = skMax<SKint32>(y1, clip.y1);
+    y2 = skMin<SKint32>(y2, clip.y2);
+
+    const SKuint32 nrEdges = m_edges.size();
+    for (SKint32 y = y1; y < y2; ++y)
+    {
+        const skScalar yc = skScalar(y) + skScalar(0.5);
+
+        m_crossings.resizeFast(0);
+        for (SKuint32 i = 0; i < nrEdges; ++i)
+        {
+            const SKsoftwareEdge& edge = m_edges[i];
+            if (yc < edge.y0 || yc >= edge.y1)
+                continue;
+
+            SKsoftwareCrossing cross;
+            cross.x   = edge.x0 + (yc - edge.y0) * edge.dxdy;
+            cross.dir = edge.dir;
+
+            // insertion sort, the list is usually very short
+            m_crossings.push_back(cross);
+
+            SKuint32 j = m_crossings.size() - 1;
+            while (j > 0 && m_crossings[j - 1].x > cross.x)
+            {
+                m_crossings[j] = m_crossings[j - 1];
+                --j;
+            }
+            m_crossings[j] = cross;
+        }
+
+        // the even-odd rule only looks at the lowest bit
+        const SKint32 mask = rule == SK_EVEN_ODD ? 1 : ~0;
+
+        SKint32        winding = 0;
+        skScalar       start   = 0;
+        const SKuint32 nrCross = m_crossings.size();
+        for (SKuint32 i = 0; i < nrCross; ++i)
+        {
+            const SKsoftwareCrossing& cross = m_crossings[i];
+
+            const SKint32 prev = winding & mask;
+            winding += cross.dir;
+
+            if (prev == 0 && (winding & mask) != 0)
+                start = cross.x;
+            else if (prev != 0 && (winding & mask) == 0)
+                fillSpan(y, start, cross.x, clip, dst, shader, grad);
+        }
+    }
+}
+
+void skSoftwareRasterizer::addLine(skScalar x0, skScalar y0, skScalar x1, skScalar y1)
+{
+    if (skEqT(y0, y1, skScalar(1e-6)))
+        return;
+
+    SKsoftwareLine line;
+    if (y0 < y1)
+        line = {x0, y0, x1, y1, 1};
+    else
+        line = {x1, y1, x0, y0, -1};
+    m_lines.push_back(line);
+}
+
+void skSoftwareRasterizer::addClippedLine(skScalar x0,
+                                          skScalar y0,
+                                          skScalar x1,
+                                          skScalar y1,
+                                          skScalar right)
+{
+    // Coverage only flows left to right, so anything past the right
+    // side of the clip can be dropped, and anything past the left
+    // side folds into a vertical line on the boundary.
+    skScalar t[4];
+    int      nr = 0;
+
+    t[nr++] = 0;
+    if (!skEqT(x0, x1, skScalar(1e-6)))
+    {
+        const skScalar tl = (0 - x0) / (x1 - x0);
+        const skScalar tr = (right - x0) / (x1 - x0);
+        if (tl > 0 && tl < 1)
+            t[nr++] = tl;
+        if (tr > 0 && tr < 1)
+            t[nr++] = tr;
+        if (nr == 3 && t[2] < t[1])
+            skSwap(t[1], t[2]);
+    }
+    t[nr++] = 1;
+
+    for (int i = 0; i + 1 < nr; ++i)
+    {
+        const skScalar ya = y0 + (y1 - y0) * t[i];
+        const skScalar yb = y0 + (y1 - y0) * t[i + 1];
+        const skScalar xm = x0 + (x1 - x0) * (t[i] + t[i + 1]) * skScalar(0.5);
+
+        if (xm <= 0)
+            addLine(0, ya, 0, yb);
+        else if (xm < right)
+        {
+            addLine(skClamp<skScalar>(x0 + (x1 - x0) * t[i], 0, right),
+                    ya,
+                    skClamp<skScalar>(x0 + (x1 - x0) * t[i + 1], 0, right),
+                    yb);
+        }
+    }
+}
+
+void skSoftwareRasterizer::accumulate(const SKsoftwareLine& line,
+                                      SKint32               y1,
+                                      SKint32               y2,
+                                      SKint32               stride,
+                                      skScalar              right)
+{
+    // Deposits the signed area of the line in each cell it crosses,
+    // plus the remainder in the cell to its right, so that a running
+    // sum along the row gives the exact coverage of every pixel.
+    const SKint32 ys = skMax<SKint32>(skSoftwareFloor(line.y0), y1);
+    const SKint32 ye = skMin<SKint32>(skSoftwareCeil(line.y1), y2);
+    if (ys >= ye)
+        return;
+
+    const skScalar dxdy = (line.x1 - line.x0) / (line.y1 - line.y0);
+
+    skScalar x = line.x0 + (skMax<skScalar>(skScalar(ys), line.y0) - line.y0) * dxdy;
+
+    for (SKint32 y = ys; y < ye; ++y)
+    {
+        skScalar* row = m_cover.ptr() + (SKsize)(y - y1) * stride;
+
+        const skScalar dy    = skMin<skScalar>(skScalar(y + 1), line.y1) - skMax<skScalar>(skScalar(y), line.y0);
+        const skScalar xnext = x + dxdy * dy;
+        const skScalar d     = dy * line.dir;
+
+        // stepping can drift a hair outside of the clip
+        const skScalar xa = skClamp<skScalar>(x, 0, right);
+        const skScalar xb = skClamp<skScalar>(xnext, 0, right);
+
+        const skScalar x0 = skMin(xa, xb);
+        const skScalar x1 = skMax(xa, xb);
+
+        const skScalar x0floor = (skScalar)skSoftwareFloor(x0);
+        const SKint32  x0i     = (SKint32)x0floor;
+        const skScalar x1ceil  = (skScalar)skSoftwareCeil(x1);
+        const SKint32  x1i     = (SKint32)x1ceil;
+
+        if (x1i <= x0i + 1)
+        {
+            const skScalar xmf = skScalar(0.5) * (xa + xb) - x0floor;
+
+            row[x0i] += d - d * xmf;
+            row[x0i + 1] += d * xmf;
+        }
+        else
+        {
+            const skScalar s   = 1 / (x1 - x0);
+            const skScalar x0f = x0 - x0floor;
+            const skScalar a0  = skScalar(0.5) * s * (1 - x0f) * (1 - x0f);
+            const skScalar x1f = x1 - x1ceil + 1;
+            const skScalar am  = skScalar(0.5) * s * x1f * x1f;
+
+            row[x0i] += d * a0;
+
+            if (x1i == x0i + 2)
+                row[x0i + 1] += d * (1 - a0 - am);
+            else
+            {
+                const skScalar a1 = s * (skScalar(1.5) - x0f);
+                row[x0i + 1] += d * (a1 - a0);
+
+                for (SKint32 xi = x0i + 2; xi < x1i - 1; ++xi)
+                    row[xi] += d * s;
+
+                const skScalar a2 = a1 + skScalar(x1i - x0i - 3) * s;
+                row[x1i - 1] += d * (1 - a2 - am);
+            }
+            row[x1i] += d * am;
+        }
+        x = xnext;
+    }
+}
+
+void skSoftwareRasterizer::fillPolygonAA(const skVertex*          pts,
+                                         SKuint32                 count,
+                                         SKfillRule               rule,
+                                         const SKsoftwareClip&    clip,
+                                         const skSoftwareSurface& dst,
+                                         const skSoftwareShader&  shader)
+{
+    if (!pts || count < 3)
+        return;
+
+    const SKint32 w = clip.x2 - clip.x1;
+    if (w <= 0 || clip.y2 <= clip.y1)
+        return;
+
+    SKsoftwareGradient grad = {};
+    if (!shader.isSolid() && !makeGradient(pts, count, grad))
+        return;
+
+    const skScalar left = skScalar(clip.x1);
+
+    m_lines.resizeFast(0);
+
+    skScalar yMin = pts[0].y, yMax = pts[0].y;
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        const skVertex& a = pts[i];
+        const skVertex& b = pts[(i + 1) % count];
+
+        yMin = skMin(yMin, a.y);
+        yMax = skMax(yMax, a.y);
+
+        addClippedLine(a.x - left, a.y, b.x - left, b.y, skScalar(w));
+    }
+
+    if (m_lines.empty())
+        return;
+
+    const SKint32 y1 = skMax<SKint32>(skSoftwareFloor(yMin), clip.y1);
+    const SKint32 y2 = skMin<SKint32>(skSoftwareCeil(yMax), clip.y2);
+
+    // one spare cell for the remainder of the right most
+    // pixel, and one for the line that lands on its edge
+    const SKint32 stride = w + 2;
+
+    const SKuint32 size = (SKuint32)(stride * SK_SOFTWARE_AA_STRIP);
+    if (m_cover.size() < size)
+    {
+        const SKuint32 old = m_cover.size();
+        m_cover.resize(size);
+        for (SKuint32 i = old; i < size; ++i)
+            m_cover[i] = 0;
+    }
+
+    const SKuint32 nrLines = m_lines.size();
+
+    SKcolor4b col = shader.getSolid();
+    for (SKint32 sy = y1; sy < y2; sy += SK_SOFTWARE_AA_STRIP)
+    {
+        const SKint32 ey = skMin<SKint32>(sy + SK_SOFTWARE_AA_STRIP, y2);
+
+        for (SKuint32 i = 0; i < nrLines; ++i)
+            accumulate(m_lines[i], sy, ey, stride, skScalar(w));
+
+        for (SKint32 y = sy; y < ey; ++y)
+        {
+            skScalar*      row = m_cover.ptr() + (SKsize)(y - sy) * stride;
+            const skScalar py  = skScalar(y) + skScalar(0.5) - grad.y0;
+
+            skScalar acc = 0;
+            for (SKint32 x = 0; x < w; ++x)
+            {
+                acc += row[x];
+                row[x] = 0;
+
+                // the sum picks up rounding noise that depends on where
+                // the clip starts, so it is snapped before it is used
+                skScalar cover = skAbs(acc);
+                cover          = skScalar(SKint32(cover * skScalar(4096) + skScalar(0.5))) / skScalar(4096);
+                if (rule == SK_EVEN_ODD)
+                {
+                    // folds the accumulated winding into [0, 1]
+                    cover -= skScalar(2) * skScalar(SKint32(cover * skScalar(0.5)));
+                    if (cover > 1)
+                        cover = skScalar(2) - cover;
+                }
+                else
+                    cover = skMin<skScalar>(cover, 1);
+                if (cover < skScalar(1.0 / 512.0))
+                    continue;
+
+                if (!shader.isSolid())
+                {
+                    const skScalar px = skScalar(x) + left + skScalar(0.5) - grad.x0;
+
+                    shader.shade(grad.u0 + grad.dudx * px + grad.dudy * py,
+                                 grad.v0 + grad.dvdx * px + grad.dvdy * py,
+                                 col);
+                }
+                else
+                    col.a = shader.getSolid().a;
+
+                col.a = (SKubyte)(skScalar(col.a) * cover + skScalar(0.5));
+                dst.blendPixel(clip.x1 + x, y, col);
+            }
+
+            row[w]     = 0;
+            row[w + 1] = 0;
+        }
+    }
+}
+
+void skSoftwareRasterizer::fillTriangle(const skVertex&          a,
+                                        const skVertex&          b,
+                                        const skVertex&          c,
+                                        const SKsoftwareClip&    clip,
+                                        const skSoftwareSurface& dst,
+                                        const skSoftwareShader&  shader) const
+{
+    const skScalar area = skSoftwareEdgeFunc(a, b, c.x, c.y);
+    if (skAbs(area) < skScalar(1e-6))
+        return;
+
+    // keep a single winding so the edge tests share a sign
+    if (area < 0)
+    {
+        fillTriangle(a, c, b, clip, dst, shader);
+        return;
+    }
+
+    const skScalar ia = 1 / area;
+
+    SKint32 x1 = skSoftwareCeil(skMin(a.x, skMin(b.x, c.x)) - skScalar(0.5));
+    SKint32 x2 = skSoftwareCeil(skMax(a.x, skMax(b.x, c.x)) - skScalar(0.5));
+    SKint32 y1 = skSoftwareCeil(skMin(a.y, skMin(b.y, c.y)) - skScalar(0.5));
+    SKint32 y2 = skSoftwareCeil(skMax(a.y, skMax(b.y, c.y)) - skScalar(0.5));
+
+    x1 = skMax<SKint32>(x1, clip.x1);
+    x2 = skMin<SKint32>(x2, clip.x2);
+    y1 = skMax<SKint32>(y1, clip.y1);
+    y2 = skMin<SKint32>(y2, clip.y2);
+
+    // Pixel centers that fall exactly on an edge belong to the
+    // triangle on its top or left side, so the triangles that
+    // make up a quad do not blend the shared edge twice.
+    const bool tlA = skSoftwareTopLeft(b, c);
+    const bool tlB = skSoftwareTopLeft(c, a);
+    const bool tlC = skSoftwareTopLeft(a, b);
+
+    SKcolor4b col = shader.getSolid();
+    for (SKint32 y = y1; y < y2; ++y)
+    {
+        const skScalar py = skScalar(y) + skScalar(0.5);
+
+        for (SKint32 x = x1; x < x2; ++x)
+        {
+            const skScalar px = skScalar(x) + skScalar(0.5);
+
+            const skScalar w0 = skSoftwareEdgeFunc(b, c, px, py);
+            const skScalar w1 = skSoftwareEdgeFunc(c, a, px, py);
+            const skScalar w2 = skSoftwareEdgeFunc(a, b, px, py);
+
+            if (w0 < 0 || w1 < 0 || w2 < 0)
+                continue;
+            if ((w0 == 0 && !tlA) || (w1 == 0 && !tlB) || (w2 == 0 && !tlC))
+                continue;
+
+            if (!shader.isSolid())
+            {
+                shader.shade((w0 * a.u + w1 * b.u + w2 * c.u) * ia,
+                             (w0 * a.v + w1 * b.v + w2 * c.v) * ia,
+                             col);
+            }
+            dst.blendPixel(x, y, col);
+        }
+    }
+}
+
+void skSoftwareRasterizer::fillTriangles(const skVertex*          pts,
+                                         SKuint32                 count,
+                                         bool                     fan,
+                                         const SKsoftwareClip&    clip,
+                                         const skSoftwareSurface& dst,
+                                         const skSoftwareShader&  shader)
+{
+    if (!pts || count < 3)
+        return;
+
+    if (fan)
+    {
+        for (SKuint32 i = 1; i + 1 < count; ++i)
+            fillTriangle(pts[0], pts[i], pts[i + 1], clip, dst, shader);
+    }
+    else
+    {
+        for (SKuint32 i = 0; i + 2 < count; i += 3)
+            fillTriangle(pts[i], pts[i + 1], pts[i + 2], clip, dst, shader);
+    }
+}
+
+void skSoftwareRasterizer::drawHairline(const skVertex&          a,
+                                        const skVertex&          b,
+                                        bool                     last,
+                                        const SKsoftwareClip&    clip,
+                                        const skSoftwareSurface& dst,
+                                        const skSoftwareShader&  shader) const
+{
+    const skScalar dx    = b.x - a.x;
+    const skScalar dy    = b.y - a.y;
+    SKint32        steps = skSoftwareCeil(skMax(skAbs(dx), skAbs(dy)));
+
+    // the end point is left to the next segment of a strip
+    if (last)
+        ++steps;
+    if (steps <= 0)
+        return;
+
+    const skScalar sx = steps > 1 ? dx / skScalar(last ? steps - 1 : steps) : 0;
+    const skScalar sy = steps > 1 ? dy / skScalar(last ? steps - 1 : steps) : 0;
+
+    const SKcolor4b& col = shader.getSolid();
+
+    skScalar x = a.x, y = a.y;
+    for (SKint32 i = 0; i < steps; ++i, x += sx, y += sy)
+    {
+        const SKint32 px = skSoftwareFloor(x);
+        const SKint32 py = skSoftwareFloor(y);
+
+        if (px >= clip.x1 && px < clip.x2 && py >= clip.y1 && py < clip.y2)
+            dst.blendPixel(px, py, col);
+    }
+}
+
+void skSoftwareRasterizer::drawWideLine(const skVertex&          a,
+                                        const skVertex&          b,
+                                        skScalar                 width,
+                                        const SKsoftwareClip&    clip,
+                                        const skSoftwareSurface& dst,
+                                        const skSoftwareShader&  shader) const
+{
+    const skScalar dx  = b.x - a.x;
+    const skScalar dy  = b.y - a.y;
+    const skScalar len = skSqrt(dx * dx + dy * dy);
+    if (skIsZero(len))
+        return;
+
+    const skScalar nx = -dy / len * width * skScalar(0.5);
+    const skScalar ny = dx / len * width * skScalar(0.5);
+
+    const skVertex q0(a.x + nx, a.y + ny);
+    const skVertex q1(b.x + nx, b.y + ny);
+    const skVertex q2(b.x - nx, b.y - ny);
+    const skVertex q3(a.x - nx, a.y - ny);
+
+    fillTriangle(q0, q1, q2, clip, dst, shader);
+    fillTriangle(q0, q2, q3, clip, dst, shader);
+}
+
+void skSoftwareRasterizer::drawLines(const skVertex*          pts,
+                                     SKuint32                 count,
+                                     bool                     strip,
+                                     skScalar                 width,
+                                     const SKsoftwareClip&    clip,
+                                     const skSoftwareSurface& dst,
+                                     const skSoftwareShader&  shader)
+{
+    if (!pts || count < 2)
+        return;
+
+    const SKuint32 step = strip ? 1 : 2;
+    for (SKuint32 i = 0; i + 1 < count; i += step)
+    {
+        if (width > 1)
+            drawWideLine(pts[i], pts[i + 1], width, clip, dst, shader);
+        else
+            drawHairline(pts[i], pts[i + 1], !strip || i + 2 == count, clip, dst, shader);
+    }
+}
+
+void skSoftwareRasterizer::drawPoints(const skVertex*          pts,
+                                      SKuint32                 count,
+                                      skScalar                 size,
+                                      const SKsoftwareClip&    clip,
+                                      const skSoftwareSurface& dst,
+                                      const skSoftwareShader&  shader)
+{
+    if (!pts)
+        return;
+
+    const skScalar   hs  = skMax<skScalar>(size, 1) * skScalar(0.5);
+    const SKcolor4b& col = shader.getSolid();
+
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        SKint32 x1 = skSoftwareCeil(pts[i].x - hs - skScalar(0.5));
+        SKint32 x2 = skSoftwareCeil(pts[i].x + hs - skScalar(0.5));
+        SKint32 y1 = skSoftwareCeil(pts[i].y - hs - skScalar(0.5));
+        SKint32 y2 = skSoftwareCeil(pts[i].y + hs - skScalar(0.5));
+
+        x1 = skMax<SKint32>(x1, clip.x1);
+        x2 = skMin<SKint32>(x2, clip.x2);
+        y1 = skMax<SKint32>(y1, clip.y1);
+        y2 = skMin<SKint32>(y2, clip.y2);
+
+        for (SKint32 y = y1; y < y2; ++y)
+            dst.blendSpan(y, x1, x2, col);
+    }
+}
+
+void skSoftwareRasterizer::draw(const SKsoftwareCommand& cmd,
+                                const skVertex*          vertices,
+                                const SKsoftwareClip&    clip,
+                                const skSoftwareSurface& dst)
+{
+    // the pattern is bound here since commands are copied around
+    skSoftwareShader shader = cmd.shader;
+    shader.setPattern(&cmd.pattern);
+
+    const skVertex* pts = vertices + cmd.first;
+
+    switch (cmd.op)
+    {
+    case SK_SW_POLYGON:
+        fillPolygon(pts, cmd.count, cmd.rule, clip, dst, shader);
+        break;
+    case SK_SW_POLYGON_AA:
+        fillPolygonAA(pts, cmd.count, cmd.rule, clip, dst, shader);
+        break;
+    case SK_SW_TRIANGLES:
+        fillTriangles(pts, cmd.count, false, clip, dst, shader);
+        break;
+    case SK_SW_LINE_STRIP:
+        drawLines(pts, cmd.count, true, cmd.width, clip, dst, shader);
+        break;
+    case SK_SW_LINES:
+        drawLines(pts, cmd.count, false, cmd.width, clip, dst, shader);
+        break;
+    case SK_SW_POINTS:
+        drawPoints(pts, cmd.count, cmd.width, clip, dst, shader);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,215 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSoftwareRasterizer_h_
+#define _skSoftwareRasterizer_h_
+
+#include "Software/skSoftwareSurface.h"
+#include "skContour.h"
+
+typedef struct SKsoftwareClip
+{
+    // half open pixel range [x1, x2) x [y1, y2)
+    SKint32 x1, y1, x2, y2;
+} SKsoftwareClip;
+
+typedef struct SKsoftwareEdge
+{
+    skScalar x0, y0;
+    skScalar y1;
+    skScalar dxdy;
+    SKint32  dir;
+} SKsoftwareEdge;
+
+typedef struct SKsoftwareLine
+{
+    skScalar x0, y0;
+    skScalar x1, y1;
+    skScalar dir;
+} SKsoftwareLine;
+
+typedef struct SKsoftwareCrossing
+{
+    skScalar x;
+    SKint32  dir;
+} SKsoftwareCrossing;
+
+typedef struct SKsoftwareGradient
+{
+    skScalar x0, y0;
+    skScalar u0, v0;
+    skScalar dudx, dudy;
+    skScalar dvdx, dvdy;
+} SKsoftwareGradient;
+
+// Mirrors the builtin fragment programs in Pipeline/
+class skSoftwareShader
+{
+private:
+    SKint32                  m_mode;
+    skColor                  m_surface;
+    skColor                  m_brush;
+    const skSoftwareSurface* m_pattern;
+    bool                     m_font;
+    SKcolor4b                m_solid;
+
+public:
+    skSoftwareShader();
+
+    void setup(SKint32        mode,
+               const skColor& surface,
+               const skColor& brush,
+               bool           font);
+
+    void setPattern(const skSoftwareSurface* pattern);
+
+    void shade(skScalar u, skScalar v, SKcolor4b& col) const;
+
+    bool isSolid(void) const
+    {
+        return m_pattern == nullptr;
+    }
+
+    const SKcolor4b& getSolid(void) const
+    {
+        return m_solid;
+    }
+};
+
+enum SKsoftwareOp
+{
+    SK_SW_POLYGON,
+    SK_SW_POLYGON_AA,
+    SK_SW_TRIANGLES,
+    SK_SW_LINE_STRIP,
+    SK_SW_LINES,
+    SK_SW_POINTS,
+};
+
+typedef struct SKsoftwareCommand
+{
+    SKint32           op;
+    SKuint32          first;
+    SKuint32          count;
+    skScalar          width;
+    SKfillRule        rule;
+    skSoftwareShader  shader;
+    skSoftwareSurface pattern;
+    // covered tiles [tx1, tx2) x [ty1, ty2)
+    SKint32 tx1, ty1, tx2, ty2;
+} SKsoftwareCommand;
+
+// Vertices are in pixel units, with the origin at the top left
+// corner of the surface and pixel centers at n + 0.5.
+class skSoftwareRasterizer
+{
+private:
+    skArray<SKsoftwareEdge>     m_edges;
+    skArray<SKsoftwareCrossing> m_crossings;
+    skArray<SKsoftwareLine>     m_lines;
+    skArray<skScalar>           m_cover;
+
+public:
+    skSoftwareRasterizer() = default;
+
+    void draw(const SKsoftwareCommand& cmd,
+              const skVertex*          vertices,
+              const SKsoftwareClip&    clip,
+              const skSoftwareSurface& dst);
+
+    void fillPolygon(const skVertex*          pts,
+                     SKuint32                 count,
+                     SKfillRule               rule,
+                     const SKsoftwareClip&    clip,
+                     const skSoftwareSurface& dst,
+                     const skSoftwareShader&  shader);
+
+    void fillPolygonAA(const skVertex*          pts,
+                       SKuint32                 count,
+                       SKfillRule               rule,
+                       const SKsoftwareClip&    clip,
+                       const skSoftwareSurface& dst,
+                       const skSoftwareShader&  shader);
+
+    void fillTriangles(const skVertex*          pts,
+                       SKuint32                 count,
+                       bool                     fan,
+                       const SKsoftwareClip&    clip,
+                       const skSoftwareSurface& dst,
+                       const skSoftwareShader&  shader);
+
+    void drawLines(const skVertex*          pts,
+                   SKuint32                 count,
+                   bool                     strip,
+                   skScalar                 width,
+                   const SKsoftwareClip&    clip,
+                   const skSoftwareSurface& dst,
+                   const skSoftwareShader&  shader);
+
+    void drawPoints(const skVertex*          pts,
+                    SKuint32                 count,
+                    skScalar                 size,
+                    const SKsoftwareClip&    clip,
+                    const skSoftwareSurface& dst,
+                    const skSoftwareShader&  shader);
+
+private:
+    void fillTriangle(const skVertex&          a,
+                      const skVertex&          b,
+                      const skVertex&          c,
+                      const SKsoftwareClip&    clip,
+                      const skSoftwareSurface& dst,
+                      const skSoftwareShader&  shader) const;
+
+    void fillSpan(SKint32                   y,
+                  skScalar                  xa,
+                  skScalar                  xb,
+                  const SKsoftwareClip&     clip,
+                  const skSoftwareSurface&  dst,
+                  const skSoftwareShader&   shader,
+                  const SKsoftwareGradient& grad) const;
+
+    void addLine(skScalar x0, skScalar y0, skScalar x1, skScalar y1);
+
+    void addClippedLine(skScalar x0, skScalar y0, skScalar x1, skScalar y1, skScalar right);
+
+    void accumulate(const SKsoftwareLine& line, SKint32 y1, SKint32 y2, SKint32 stride, skScalar right);
+
+    void drawHairline(const skVertex&          a,
+                      const skVertex&          b,
+                      bool                     last,
+                      const SKsoftwareClip&    clip,
+                      const skSoftwareSurface& dst,
+                      const skSoftwareShader&  shader) const;
+
+    void drawWideLine(const skVertex&          a,
+                      const skVertex&          b,
+                      skScalar                 width,
+                      const SKsoftwareClip&    clip,
+                      const skSoftwareSurface& dst,
+                      const skSoftwareShader&  shader) const;
+
+    static bool makeGradient(const skVertex*     pts,
+                             SKuint32            count,
+                             SKsoftwareGradient& grad);
+};
+
+#endif  //_skSoftwareRasterizer_h_
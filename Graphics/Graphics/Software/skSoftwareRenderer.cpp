@@ -0,0 +1,662 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Software/skSoftwareRenderer.h"
+#include "skCachedString.h"
+#include "skContext.h"
+#include "skContour.h"
+#include "skFont.h"
+#include "skPaint.h"
+#include "skPath.h"
+
+typedef struct SKsoftwareClear
+{
+    const skSoftwareSurface* surface;
+    SKcolor4b                color;
+} SKsoftwareClear;
+
+static void skSoftwareClearBand(void* user, SKuint32, SKuint32 band)
+{
+    const SKsoftwareClear* clr = (const SKsoftwareClear*)user;
+
+    const SKint32 y1 = (SKint32)band * SK_SOFTWARE_TILE_SIZE;
+    clr->surface->clear(clr->color, y1, y1 + SK_SOFTWARE_TILE_SIZE);
+}
+
+skSoftwareRenderer::skSoftwareRenderer() :
+    m_projection(skMatrix4::Identity),
+    m_viewProj(skMatrix4::Identity),
+    m_viewport(0, 0, 0, 0),
+    m_savedProjection(skMatrix4::Identity),
+    m_savedViewport(0, 0, 0, 0),
+    m_pixels(0, 0, 0, 0),
+    m_target(nullptr),
+    m_bound(nullptr),
+    m_tilesX(0),
+    m_tilesY(0),
+    m_fontPath(new skPath()),
+    m_curPaint(nullptr)
+{
+    m_rasterizers.push_back(new skSoftwareRasterizer());
+}
+
+skSoftwareRenderer::~skSoftwareRenderer()
+{
+    for (SKuint32 i = 0; i < m_rasterizers.size(); ++i)
+        delete m_rasterizers[i];
+
+    delete m_fontPath;
+    delete m_target;
+}
+
+skTexture* skSoftwareRenderer::getTarget(void)
+{
+    validateTarget();
+    flush();
+    return m_target;
+}
+
+bool skSoftwareRenderer::validateTarget(void)
+{
+    SK_CHECK_PARAM(m_ctx, false);
+
+    const skVector2& size = m_ctx->getSize();
+
+    const SKint32 w = skMax<SKint32>((SKint32)size.x, 1);
+    const SKint32 h = skMax<SKint32>((SKint32)size.y, 1);
+
+    if (!m_target || m_target->getWidth() != w || m_target->getHeight() != h)
+    {
+        // anything pending was meant for the old target
+        if (!m_bound)
+            discard();
+        delete m_target;
+
+        m_target = m_ctx->createInternalImage(w, h, SK_RGBA);
+    }
+
+    m_surface.attach(m_bound ? m_bound : m_target);
+    return m_surface.isValid();
+}
+
+void skSoftwareRenderer::bindTarget(skTexture* target)
+{
+    if (target == m_bound)
+        return;
+
+    // pending commands belong to the current surface
+    flush();
+
+    if (!m_bound)
+    {
+        m_savedProjection = m_projection;
+        m_savedViewport   = m_viewport;
+    }
+
+    m_bound = target;
+    if (m_bound)
+    {
+        // the context projects onto the target once it is bound
+        m_viewport.x      = 0;
+        m_viewport.y      = 0;
+        m_viewport.width  = (skScalar)m_bound->getWidth();
+        m_viewport.height = (skScalar)m_bound->getHeight();
+    }
+    else
+    {
+        m_projection = m_savedProjection;
+        m_viewport   = m_savedViewport;
+    }
+    validateTarget();
+}
+
+void skSoftwareRenderer::resolveTarget(skTexture*)
+{
+    // the image is the target, so it only needs the pending commands
+    flush();
+}
+
+void skSoftwareRenderer::readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest)
+{
+    SK_CHECK_PARAM(dest, SK_RETURN_VOID);
+
+    if (w <= 0 || h <= 0 || !validateTarget())
+        return;
+
+    flush();
+
+    // rows are returned bottom up from a lower left origin, like glReadPixels
+    const SKint32 height = m_surface.getHeight();
+    for (SKint32 r = 0; r < h; ++r)
+        m_surface.readSpan(height - 1 - (y + r), x, x + w, dest + (SKsize)r * w * 4);
+}
+
+void skSoftwareRenderer::getStateCalls(SKuint32& issued, SKuint32& skipped) const
+{
+    // there is no device state to track
+    issued  = 0;
+    skipped = 0;
+}
+
+void skSoftwareRenderer::resetStateCalls(void)
+{
+}
+
+void skSoftwareRenderer::invalidateState(void)
+{
+}
+
+void skSoftwareRenderer::validateWorkers(void)
+{
+    const SKuint32 nr = (SKuint32)m_ctx->getContextI(SK_WORKER_THREADS);
+    if (nr == m_workers.getThreadCount())
+        return;
+
+    flush();
+    m_workers.setThreadCount(nr);
+
+    while (m_rasterizers.size() < m_workers.getThreadCount())
+        m_rasterizers.push_back(new skSoftwareRasterizer());
+}
+
+void skSoftwareRenderer::projectBox(skScalar x1, skScalar y1, skScalar x2, skScalar y2)
+{
+    skMath::ortho2D(m_projection, x1, y1, x2, y2);
+}
+
+void skSoftwareRenderer::clear(void)
+{
+    skRectangle rect;
+    rect.setPosition(0, 0);
+
+    if (m_bound)
+        rect.setSize(skVector2((skScalar)m_bound->getWidth(), (skScalar)m_bound->getHeight()));
+    else
+        rect.setSize(ref().getSize());
+    clear(rect);
+}
+
+void skSoftwareRenderer::clear(const skRectangle& rect)
+{
+    if (!validateTarget())
+        return;
+
+    validateWorkers();
+
+    // nothing drawn before the clear can show through it
+    discard();
+
+    const skContext& ctx = ref();
+
+    // Like glClear, the whole target is cleared and
+    // the rectangle only defines the viewport.
+    if (!ctx.getContextI(SK_USE_CURRENT_VIEWPORT))
+        m_viewport = rect;
+
+    const skColor& clear = ctx.getContextC(SK_CLEAR_COLOR);
+
+    SKsoftwareClear clr;
+    clr.surface = &m_surface;
+    clear.asInt8(clr.color.r, clr.color.g, clr.color.b, clr.color.a);
+
+    const SKint32 bands = (m_surface.getHeight() + SK_SOFTWARE_TILE_SIZE - 1) / SK_SOFTWARE_TILE_SIZE;
+    m_workers.run(skSoftwareClearBand, &clr, (SKuint32)bands);
+}
+
+void skSoftwareRenderer::setupView(void)
+{
+    m_viewProj = m_projection * ref().getMatrix();
+
+    skScalar vx = m_viewport.x, vy = m_viewport.y;
+    skScalar vw = m_viewport.width, vh = m_viewport.height;
+    if (vw <= 0 || vh <= 0)
+    {
+        vx = 0;
+        vy = 0;
+        vw = (skScalar)m_surface.getWidth();
+        vh = (skScalar)m_surface.getHeight();
+    }
+
+    // the viewport origin is the lower left corner, the same as glViewport
+    m_pixels.x      = vx;
+    m_pixels.y      = (skScalar)m_surface.getHeight() - vy - vh;
+    m_pixels.width  = vw;
+    m_pixels.height = vh;
+}
+
+void skSoftwareRenderer::project(skScalar x, skScalar y, skScalar& px, skScalar& py) const
+{
+    const skScalar* m = m_viewProj.p;
+
+    skScalar cx = m[0] * x + m[1] * y + m[3];
+    skScalar cy = m[4] * x + m[5] * y + m[7];
+
+    const skScalar cw = m[12] * x + m[13] * y + m[15];
+    if (!skIsZero(cw))
+    {
+        cx /= cw;
+        cy /= cw;
+    }
+
+    px = m_pixels.x + (cx + 1) * skScalar(0.5) * m_pixels.width;
+    py = m_pixels.y + (1 - cy) * skScalar(0.5) * m_pixels.height;
+}
+
+void skSoftwareRenderer::setupShader(skSoftwareShader& shader, bool font) const
+{
+    const skScalar opacity = ref().getContextF(SK_OPACITY);
+
+    skColor surface = m_curPaint->m_surfaceColor;
+    skColor brush   = m_curPaint->m_brushColor;
+    surface.a *= opacity;
+    brush.a *= opacity;
+
+    shader.setup(m_curPaint->m_brushMode, surface, brush, font);
+}
+
+bool skSoftwareRenderer::unrollSubpaths(const skContour* contour, SKint32& op)
+{
+    const bool polygon = op == SK_SW_POLYGON || op == SK_SW_POLYGON_AA;
+    if (!polygon && op != SK_SW_LINE_STRIP)
+        return false;
+
+    m_subpathIndices.resizeFast(0);
+    for (SKuint32 i = 0; i < contour->subpathCount(); ++i)
+    {
+        SKuint32 first, count;
+        contour->getSubpath(i, first, count);
+
+        if (polygon)
+        {
+            // Each subpath is closed back to its start and then returns
+            // to the first vertex of the path, so every edge between
+            // subpaths is walked there and back again and cancels out.
+            for (SKuint32 j = 0; j < count; ++j)
+                m_subpathIndices.push_back(first + j);
+            m_subpathIndices.push_back(first);
+            m_subpathIndices.push_back(0);
+        }
+        else
+        {
+            for (SKuint32 j = 0; j + 1 < count; ++j)
+            {
+                m_subpathIndices.push_back(first + j);
+                m_subpathIndices.push_back(first + j + 1);
+            }
+        }
+    }
+
+    if (!polygon)
+        op = SK_SW_LINES;
+    return true;
+}
+
+void skSoftwareRenderer::unrollTriangles(const skContour* contour)
+{
+    // Each triangle is closed as its own subpath, the same
+    // way unrollSubpaths joins the outlines of a fill.
+    const skIndices& idx = contour->indices;
+
+    m_subpathIndices.resizeFast(0);
+    for (SKuint32 i = 0; i + 2 < idx.size(); i += 3)
+    {
+        m_subpathIndices.push_back(idx[i]);
+        m_subpathIndices.push_back(idx[i + 1]);
+        m_subpathIndices.push_back(idx[i + 2]);
+        m_subpathIndices.push_back(idx[i]);
+        m_subpathIndices.push_back(idx[0]);
+    }
+}
+
+void skSoftwareRenderer::submit(const skPath* pth, SKsoftwareCommand& cmd)
+{
+    const skContour* contour = pth->getContour();
+    const skPoly&    src     = contour->vertices;
+
+    // indexed contours are expanded back into a triangle list
+    const SKuint32* idx = contour->indexed() ? contour->indices.ptr() : nullptr;
+    SKuint32        nr  = idx ? contour->indices.size() : src.size();
+
+    if (idx && (cmd.op == SK_SW_POLYGON || cmd.op == SK_SW_POLYGON_AA))
+    {
+        unrollTriangles(contour);
+        idx = m_subpathIndices.ptr();
+        nr  = m_subpathIndices.size();
+    }
+    else if (!idx && contour->subpathCount() > 1)
+    {
+        if (unrollSubpaths(contour, cmd.op))
+        {
+            idx = m_subpathIndices.ptr();
+            nr  = m_subpathIndices.size();
+        }
+    }
+
+    const bool deferred = m_workers.getThreadCount() > 1;
+    if (deferred)
+    {
+        // Bin by the projected bounds, padded for wide pens and
+        // rounding. Commands that miss the target are dropped.
+        const skBoundingBox2D& bb = pth->getAabb();
+
+        skScalar x[4], y[4];
+        project(bb.x1, bb.y1, x[0], y[0]);
+        project(bb.x2, bb.y1, x[1], y[1]);
+        project(bb.x2, bb.y2, x[2], y[2]);
+        project(bb.x1, bb.y2, x[3], y[3]);
+
+        const skScalar pad = (cmd.width > 1 ? cmd.width * skScalar(0.5) : 0) + 1;
+
+        skScalar x1 = x[0], y1 = y[0], x2 = x[0], y2 = y[0];
+        for (int i = 1; i < 4; ++i)
+        {
+            x1 = skMin(x1, x[i]);
+            y1 = skMin(y1, y[i]);
+            x2 = skMax(x2, x[i]);
+            y2 = skMax(y2, y[i]);
+        }
+
+        const skScalar ts = skScalar(SK_SOFTWARE_TILE_SIZE);
+
+        const SKint32 tilesX = (m_surface.getWidth() + SK_SOFTWARE_TILE_SIZE - 1) / SK_SOFTWARE_TILE_SIZE;
+        const SKint32 tilesY = (m_surface.getHeight() + SK_SOFTWARE_TILE_SIZE - 1) / SK_SOFTWARE_TILE_SIZE;
+
+        cmd.tx1 = (SKint32)skClamp<skScalar>((x1 - pad) / ts, 0, (skScalar)tilesX);
+        cmd.ty1 = (SKint32)skClamp<skScalar>((y1 - pad) / ts, 0, (skScalar)tilesY);
+        cmd.tx2 = (SKint32)skClamp<skScalar>((x2 + pad) / ts + 1, 0, (skScalar)tilesX);
+        cmd.ty2 = (SKint32)skClamp<skScalar>((y2 + pad) / ts + 1, 0, (skScalar)tilesY);
+
+        if (cmd.tx1 >= cmd.tx2 || cmd.ty1 >= cmd.ty2)
+            return;
+    }
+
+    cmd.first = m_vertices.size();
+    cmd.count = nr;
+    m_vertices.resize(cmd.first + nr);
+
+    skVertex* dst = m_vertices.ptr() + cmd.first;
+    for (SKuint32 i = 0; i < nr; ++i)
+    {
+        const skVertex& v = src[idx ? idx[i] : i];
+        project(v.x, v.y, dst[i].x, dst[i].y);
+        dst[i].u = v.u;
+        dst[i].v = v.v;
+    }
+
+    if (deferred)
+        m_commands.push_back(cmd);
+    else
+    {
+        const SKsoftwareClip clip = {0, 0, m_surface.getWidth(), m_surface.getHeight()};
+        m_rasterizers[0]->draw(cmd, m_vertices.ptr(), clip, m_surface);
+        m_vertices.resizeFast(0);
+    }
+}
+
+void skSoftwareRenderer::fill(skPath* pth)
+{
+    SK_CHECK_PARAM(pth, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_curPaint, SK_RETURN_VOID);
+
+    pth = pth->getSimplePath();
+
+    if (pth->isEmpty() || !validateTarget())
+        return;
+
+    validateWorkers();
+    setupView();
+
+    SKsoftwareCommand cmd;
+    cmd.op    = ref().getContextI(SK_ANTI_ALIAS) ? SK_SW_POLYGON_AA : SK_SW_POLYGON;
+    cmd.width = 0;
+    cmd.rule  = m_curPaint->m_fillRule;
+    setupShader(cmd.shader, false);
+
+    if (m_curPaint->m_brushPattern)
+    {
+        pth->makeUV();
+        cmd.pattern.attach(m_curPaint->m_brushPattern);
+    }
+
+    submit(pth, cmd);
+}
+
+bool skSoftwareRenderer::fillInstanced(skPath*, const skScalar*, const SKuint32*, SKuint32)
+{
+    // each instance is binned on its own
+    return false;
+}
+
+void skSoftwareRenderer::stroke(skPath* pth)
+{
+    SK_CHECK_PARAM(pth, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_curPaint, SK_RETURN_VOID);
+
+    pth = pth->getSimplePath();
+
+    if (pth->isEmpty() || !validateTarget())
+        return;
+
+    validateWorkers();
+    setupView();
+
+    // patterns are not applied to lines
+    SKsoftwareCommand cmd;
+    cmd.width = m_curPaint->m_penWidth;
+    cmd.rule  = SK_NON_ZERO;
+    setupShader(cmd.shader, false);
+
+    switch (m_curPaint->m_lineType)
+    {
+    case SK_POINTS:
+        cmd.op = SK_SW_POINTS;
+        break;
+    case SK_LINE_LIST:
+        cmd.op = SK_SW_LINES;
+        break;
+    default:
+        cmd.op = SK_SW_LINE_STRIP;
+        break;
+    }
+
+    // dashes are cut into a line list, then drawn like any other
+    if (cmd.op != SK_SW_POINTS &&
+        m_curPaint->m_penStyle == SK_PS_DASHED &&
+        !m_curPaint->m_dashes.empty())
+    {
+        pth = pth->getDashPath(m_curPaint->m_dashes,
+                               m_curPaint->m_dashPhase,
+                               cmd.op == SK_SW_LINES);
+        if (pth->isEmpty())
+            return;
+
+        cmd.op = SK_SW_LINES;
+    }
+
+    // Wide lines fill the triangles that carry the joins and caps
+    // as one non-zero outline, so where they overlap nothing is
+    // blended twice and the edges are anti-aliased like a fill.
+    if (cmd.op != SK_SW_POINTS && cmd.width > 1)
+    {
+        pth = pth->getStrokePath(m_curPaint->m_penWidth,
+                                 m_curPaint->m_penJoin,
+                                 m_curPaint->m_penCap,
+                                 cmd.op == SK_SW_LINES);
+        if (pth->isEmpty())
+            return;
+
+        cmd.op    = ref().getContextI(SK_ANTI_ALIAS) ? SK_SW_POLYGON_AA : SK_SW_POLYGON;
+        cmd.width = 0;
+    }
+
+    submit(pth, cmd);
+}
+
+void skSoftwareRenderer::drawText(skPath* pth, skTexture* image)
+{
+    if (pth->isEmpty() || !validateTarget())
+        return;
+
+    validateWorkers();
+    setupView();
+
+    SKsoftwareCommand cmd;
+    cmd.op    = SK_SW_TRIANGLES;
+    cmd.width = 0;
+    cmd.rule  = SK_NON_ZERO;
+    setupShader(cmd.shader, true);
+
+    cmd.pattern.attach(image);
+    if (!cmd.pattern.isValid())
+        return;
+
+    submit(pth, cmd);
+}
+
+void skSoftwareRenderer::discard(void)
+{
+    m_commands.resizeFast(0);
+    m_vertices.resizeFast(0);
+}
+
+void skSoftwareRenderer::binCommands(void)
+{
+    m_tilesX = (m_surface.getWidth() + SK_SOFTWARE_TILE_SIZE - 1) / SK_SOFTWARE_TILE_SIZE;
+    m_tilesY = (m_surface.getHeight() + SK_SOFTWARE_TILE_SIZE - 1) / SK_SOFTWARE_TILE_SIZE;
+
+    const SKuint32 nrTiles = (SKuint32)(m_tilesX * m_tilesY);
+    const SKuint32 nrCmd   = m_commands.size();
+
+    m_tileStart.resizeFast(0);
+    m_tileStart.resize(nrTiles + 1);
+    for (SKuint32 i = 0; i <= nrTiles; ++i)
+        m_tileStart[i] = 0;
+
+    // count the commands in each tile, then turn the
+    // counts into offsets into m_tileItems
+    for (SKuint32 c = 0; c < nrCmd; ++c)
+    {
+        const SKsoftwareCommand& cmd = m_commands[c];
+        for (SKint32 ty = cmd.ty1; ty < cmd.ty2; ++ty)
+            for (SKint32 tx = cmd.tx1; tx < cmd.tx2; ++tx)
+                ++m_tileStart[ty * m_tilesX + tx + 1];
+    }
+
+    for (SKuint32 i = 0; i < nrTiles; ++i)
+        m_tileStart[i + 1] += m_tileStart[i];
+
+    m_tileItems.resize(m_tileStart[nrTiles]);
+
+    // Filled in submission order, which keeps painter's order
+    // within every tile. The end offsets are shifted up by one
+    // while filling, which restores the start offsets.
+    for (SKuint32 c = 0; c < nrCmd; ++c)
+    {
+        const SKsoftwareCommand& cmd = m_commands[c];
+        for (SKint32 ty = cmd.ty1; ty < cmd.ty2; ++ty)
+        {
+            for (SKint32 tx = cmd.tx1; tx < cmd.tx2; ++tx)
+            {
+                SKuint32& pos = m_tileStart[ty * m_tilesX + tx];
+                m_tileItems[pos++] = c;
+            }
+        }
+    }
+
+    for (SKuint32 i = nrTiles; i > 0; --i)
+        m_tileStart[i] = m_tileStart[i - 1];
+    m_tileStart[0] = 0;
+}
+
+void skSoftwareRenderer::renderTile(void* user, SKuint32 worker, SKuint32 tile)
+{
+    skSoftwareRenderer* rnd = (skSoftwareRenderer*)user;
+
+    const SKint32 tx = (SKint32)tile % rnd->m_tilesX;
+    const SKint32 ty = (SKint32)tile / rnd->m_tilesX;
+
+    SKsoftwareClip clip;
+    clip.x1 = tx * SK_SOFTWARE_TILE_SIZE;
+    clip.y1 = ty * SK_SOFTWARE_TILE_SIZE;
+    clip.x2 = skMin<SKint32>(clip.x1 + SK_SOFTWARE_TILE_SIZE, rnd->m_surface.getWidth());
+    clip.y2 = skMin<SKint32>(clip.y1 + SK_SOFTWARE_TILE_SIZE, rnd->m_surface.getHeight());
+
+    skSoftwareRasterizer* rasterizer = rnd->m_rasterizers[worker];
+
+    const SKuint32 end = rnd->m_tileStart[tile + 1];
+    for (SKuint32 i = rnd->m_tileStart[tile]; i < end; ++i)
+    {
+        rasterizer->draw(rnd->m_commands[rnd->m_tileItems[i]],
+                         rnd->m_vertices.ptr(),
+                         clip,
+                         rnd->m_surface);
+    }
+}
+
+void skSoftwareRenderer::flush(void)
+{
+    if (m_commands.empty())
+    {
+        m_vertices.resizeFast(0);
+        return;
+    }
+
+    binCommands();
+    m_workers.run(renderTile, this, (SKuint32)(m_tilesX * m_tilesY));
+    discard();
+}
+
+void skSoftwareRenderer::displayString(skFont*     font,
+                                       const char* str,
+                                       SKuint32    len,
+                                       skScalar    x,
+                                       skScalar    y)
+{
+    SK_CHECK_PARAM(font, SK_RETURN_VOID);
+    SK_CHECK_PARAM(len, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_curPaint, SK_RETURN_VOID);
+
+    font->buildPath(m_fontPath, str, len, x, y);
+    drawText(m_fontPath, font->getImage());
+}
+
+void skSoftwareRenderer::displayString(skCachedString* str)
+{
+    SK_CHECK_PARAM(str, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_curPaint, SK_RETURN_VOID);
+
+    displayString(m_ctx->getWorkFont(), str->getPath());
+}
+
+void skSoftwareRenderer::displayString(skFont* font, skPath* path)
+{
+    SK_CHECK_PARAM(font, SK_RETURN_VOID);
+    SK_CHECK_PARAM(path, SK_RETURN_VOID);
+    SK_CHECK_PARAM(m_curPaint, SK_RETURN_VOID);
+
+    drawText(path, font->getImage());
+}
+
+void skSoftwareRenderer::selectPaint(skPaint* paint)
+{
+    m_curPaint = paint;
+}
@@ -0,0 +1,130 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSoftwareRenderer_h_
+#define _skSoftwareRenderer_h_
+
+#include "Software/skSoftwareRasterizer.h"
+#include "Software/skSoftwareSurface.h"
+#include "Software/skSoftwareWorkers.h"
+#include "skRender.h"
+
+#define SK_SOFTWARE_TILE_SIZE 64
+
+class skSoftwareRenderer : public skRenderer
+{
+private:
+    skMatrix4                      m_projection;
+    skMatrix4                      m_viewProj;
+    skRectangle                    m_viewport;
+    skMatrix4                      m_savedProjection;  // the context's view while a target is bound
+    skRectangle                    m_savedViewport;
+    skRectangle                    m_pixels;
+    skTexture*                     m_target;
+    skTexture*                     m_bound;
+    skSoftwareSurface              m_surface;
+    skArray<skSoftwareRasterizer*> m_rasterizers;
+    skSoftwareWorkers              m_workers;
+    skArray<SKsoftwareCommand>     m_commands;
+    skPoly                         m_vertices;
+    skIndices                      m_subpathIndices;
+    skArray<SKuint32>              m_tileStart;
+    skArray<SKuint32>              m_tileItems;
+    SKint32                        m_tilesX;
+    SKint32                        m_tilesY;
+    skPath*                        m_fontPath;
+    skPaint*                       m_curPaint;
+
+public:
+    skSoftwareRenderer();
+    ~skSoftwareRenderer() override;
+
+    void clear(void) override;
+
+    void clear(const skRectangle& rect) override;
+
+    void fill(skPath* pth) override;
+
+    bool fillInstanced(skPath*         pth,
+                       const skScalar* transforms,
+                       const SKuint32* colors,
+                       SKuint32        count) override;
+
+    void stroke(skPath* pth) override;
+
+    void flush(void) override;
+
+    void selectPaint(skPaint* paint) override;
+
+    void projectBox(skScalar x1, skScalar y1, skScalar x2, skScalar y2) override;
+
+    void displayString(skFont* font, const char* str, SKuint32 len, skScalar x, skScalar y) override;
+
+    void displayString(skCachedString* str) override;
+
+    void displayString(skFont* font, skPath* path) override;
+
+    skTexture* getTarget(void) override;
+
+    void bindTarget(skTexture* target) override;
+
+    void resolveTarget(skTexture* target) override;
+
+    void readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest) override;
+
+    void getStateCalls(SKuint32& issued, SKuint32& skipped) const override;
+
+    void resetStateCalls(void) override;
+
+    void invalidateState(void) override;
+
+private:
+    bool validateTarget(void);
+
+    void validateWorkers(void);
+
+    void setupView(void);
+
+    void project(skScalar x, skScalar y, skScalar& px, skScalar& py) const;
+
+    void setupShader(skSoftwareShader& shader, bool font) const;
+
+    void submit(const skPath* pth, SKsoftwareCommand& cmd);
+
+    // Lists an indexed triangle list as one polygon with a
+    // subpath per triangle.
+    void unrollTriangles(const skContour* contour);
+
+    // Lists the vertices of a path with subpaths in an order that
+    // op draws them apart. Polygons close every subpath and strips
+    // become line pairs.
+    bool unrollSubpaths(const skContour* contour, SKint32& op);
+
+    void drawText(skPath* pth, skTexture* image);
+
+    void discard(void);
+
+    void binCommands(void);
+
+    static void renderTile(void* user, SKuint32 worker, SKuint32 tile);
+};
+
+#endif  //_skSoftwareRenderer_h_
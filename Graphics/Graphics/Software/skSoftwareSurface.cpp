@@ -0,0 +1,254 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Software/skSoftwareSurface.h"
+#include <memory.h>
+#include "Image/skImage.h"
+
+#define SK_SOFTWARE_MAX_LAYOUTS 16
+
+skSoftwareSurface::skSoftwareSurface() :
+    m_bits(nullptr),
+    m_width(0),
+    m_height(0),
+    m_pitch(0),
+    m_layout()
+{
+}
+
+skSoftwareSurface::skSoftwareSurface(const skTexture* tex) :
+    skSoftwareSurface()
+{
+    attach(tex);
+}
+
+void skSoftwareSurface::getLayout(SKpixelFormat fmt, SKsoftwareLayout& layout)
+{
+    // per thread, so contexts on other threads never race on it
+    static thread_local SKsoftwareLayout cache[SK_SOFTWARE_MAX_LAYOUTS];
+    static thread_local bool             cached[SK_SOFTWARE_MAX_LAYOUTS] = {};
+
+    const bool cacheable = fmt >= 0 && fmt < SK_SOFTWARE_MAX_LAYOUTS;
+    if (cacheable && cached[fmt])
+    {
+        layout = cache[fmt];
+        return;
+    }
+
+    // The channel order and the row order are private to the image
+    // library, so write a known pixel into the first row of a
+    // two row probe and see where it lands.
+    skImage probe(1, 2, (skPixelFormat)fmt);
+
+    SKubyte* bits = probe.getBytes();
+    if (!bits)
+    {
+        layout = {-1, -1, -1, -1, 0, false};
+        return;
+    }
+
+    const SKint32 pitch = (SKint32)probe.getPitch();
+    memset(bits, 0, (SKsize)pitch * 2);
+    probe.setPixel(0, 0, skPixel(1, 2, 3, 4));
+
+    layout         = {-1, -1, -1, -1, (SKint32)probe.getBPP(), false};
+    layout.flipped = true;
+
+    for (SKint32 i = 0; i < layout.bpp; ++i)
+    {
+        if (bits[i] != 0)
+            layout.flipped = false;
+    }
+
+    const SKubyte* pixel = layout.flipped ? bits + pitch : bits;
+    for (SKint32 i = 0; i < layout.bpp; ++i)
+    {
+        switch (pixel[i])
+        {
+        case 1:
+            layout.r = i;
+            break;
+        case 2:
+            layout.g = i;
+            break;
+        case 3:
+            layout.b = i;
+            break;
+        case 4:
+            layout.a = i;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (layout.bpp == 1 && layout.r == -1 && layout.a == -1)
+        layout.a = 0;
+
+    if (cacheable)
+    {
+        cache[fmt]  = layout;
+        cached[fmt] = true;
+    }
+}
+
+void skSoftwareSurface::attach(const skTexture* tex)
+{
+    m_bits   = nullptr;
+    m_width  = 0;
+    m_height = 0;
+    m_pitch  = 0;
+
+    if (!tex || !tex->getBits())
+        return;
+
+    getLayout(tex->getFormat(), m_layout);
+    if (m_layout.bpp <= 0)
+        return;
+
+    m_bits   = tex->getBits();
+    m_width  = tex->getWidth();
+    m_height = tex->getHeight();
+    m_pitch  = tex->getPitch();
+}
+
+void skSoftwareSurface::clear(const SKcolor4b& col) const
+{
+    clear(col, 0, m_height);
+}
+
+void skSoftwareSurface::clear(const SKcolor4b& col, SKint32 y1, SKint32 y2) const
+{
+    y1 = skMax<SKint32>(y1, 0);
+    y2 = skMin<SKint32>(y2, m_height);
+    if (!m_bits || y1 >= y2)
+        return;
+
+    SKubyte pixel[4] = {0, 0, 0, 0};
+    if (m_layout.r >= 0)
+        pixel[m_layout.r] = col.r;
+    if (m_layout.g >= 0)
+        pixel[m_layout.g] = col.g;
+    if (m_layout.b >= 0)
+        pixel[m_layout.b] = col.b;
+    if (m_layout.a >= 0)
+        pixel[m_layout.a] = col.a;
+
+    const SKint32 bpp = skMin<SKint32>(m_layout.bpp, 4);
+    for (SKint32 y = y1; y < y2; ++y)
+    {
+        SKubyte* dst = m_bits + (SKsize)y * m_pitch;
+        for (SKint32 x = 0; x < m_width; ++x, dst += m_layout.bpp)
+            memcpy(dst, pixel, bpp);
+    }
+}
+
+void skSoftwareSurface::blend(SKubyte* dst, const SKcolor4b& col) const
+{
+    const SKuint32 sa = col.a;
+    if (sa == 0)
+        return;
+
+    if (sa == 255)
+    {
+        if (m_layout.r >= 0)
+            dst[m_layout.r] = col.r;
+        if (m_layout.g >= 0)
+            dst[m_layout.g] = col.g;
+        if (m_layout.b >= 0)
+            dst[m_layout.b] = col.b;
+        if (m_layout.a >= 0)
+            dst[m_layout.a] = 255;
+        return;
+    }
+
+    const SKuint32 ia = 255 - sa;
+    if (m_layout.r >= 0)
+        dst[m_layout.r] = (SKubyte)((col.r * sa + dst[m_layout.r] * ia + 127) / 255);
+    if (m_layout.g >= 0)
+        dst[m_layout.g] = (SKubyte)((col.g * sa + dst[m_layout.g] * ia + 127) / 255);
+    if (m_layout.b >= 0)
+        dst[m_layout.b] = (SKubyte)((col.b * sa + dst[m_layout.b] * ia + 127) / 255);
+    if (m_layout.a >= 0)
+        dst[m_layout.a] = (SKubyte)(sa + (dst[m_layout.a] * ia + 127) / 255);
+}
+
+void skSoftwareSurface::blendSpan(SKint32 y, SKint32 x1, SKint32 x2, const SKcolor4b& col) const
+{
+    if (!m_bits || y < 0 || y >= m_height || col.a == 0)
+        return;
+
+    x1 = skMax<SKint32>(x1, 0);
+    x2 = skMin<SKint32>(x2, m_width);
+
+    SKubyte* dst = row(y) + (SKsize)x1 * m_layout.bpp;
+    for (SKint32 x = x1; x < x2; ++x, dst += m_layout.bpp)
+        blend(dst, col);
+}
+
+void skSoftwareSurface::blendPixel(SKint32 x, SKint32 y, const SKcolor4b& col) const
+{
+    if (!m_bits || x < 0 || y < 0 || x >= m_width || y >= m_height)
+        return;
+
+    blend(row(y) + (SKsize)x * m_layout.bpp, col);
+}
+
+void skSoftwareSurface::sample(skScalar u, skScalar v, SKcolor4b& col) const
+{
+    if (!m_bits)
+    {
+        col = {0, 0, 0, 0};
+        return;
+    }
+
+    // Texture coordinates address the image rows in memory order,
+    // which is the same as uploading the bytes to a GL texture.
+    const SKint32 x = skClamp<SKint32>((SKint32)(u * (skScalar)m_width), 0, m_width - 1);
+    const SKint32 y = skClamp<SKint32>((SKint32)(v * (skScalar)m_height), 0, m_height - 1);
+
+    const SKubyte* src = m_bits + (SKsize)y * m_pitch + (SKsize)x * m_layout.bpp;
+
+    col.r = m_layout.r >= 0 ? src[m_layout.r] : 0;
+    col.g = m_layout.g >= 0 ? src[m_layout.g] : 0;
+    col.b = m_layout.b >= 0 ? src[m_layout.b] : 0;
+    col.a = m_layout.a >= 0 ? src[m_layout.a] : 255;
+}
+
+void skSoftwareSurface::readSpan(SKint32 y, SKint32 x1, SKint32 x2, SKubyte* dest) const
+{
+    // writes 8 bit RGBA, pixels outside of the surface are zero
+    for (SKint32 x = x1; x < x2; ++x, dest += 4)
+    {
+        if (!m_bits || x < 0 || y < 0 || x >= m_width || y >= m_height)
+        {
+            dest[0] = dest[1] = dest[2] = dest[3] = 0;
+            continue;
+        }
+
+        const SKubyte* src = row(y) + (SKsize)x * m_layout.bpp;
+
+        dest[0] = m_layout.r >= 0 ? src[m_layout.r] : 0;
+        dest[1] = m_layout.g >= 0 ? src[m_layout.g] : 0;
+        dest[2] = m_layout.b >= 0 ? src[m_layout.b] : 0;
+        dest[3] = m_layout.a >= 0 ? src[m_layout.a] : 255;
+    }
+}
@@ -0,0 +1,91 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSoftwareSurface_h_
+#define _skSoftwareSurface_h_
+
+#include "skTexture.h"
+
+typedef struct SKsoftwareLayout
+{
+    // byte offset of each channel in a pixel, or -1 if the
+    // channel is not stored by the format
+    SKint32 r, g, b, a;
+    SKint32 bpp;
+    // true if image row zero is the bottom row of the picture
+    bool flipped;
+} SKsoftwareLayout;
+
+class skSoftwareSurface
+{
+private:
+    SKubyte*         m_bits;
+    SKint32          m_width;
+    SKint32          m_height;
+    SKint32          m_pitch;
+    SKsoftwareLayout m_layout;
+
+public:
+    skSoftwareSurface();
+
+    explicit skSoftwareSurface(const skTexture* tex);
+
+    void attach(const skTexture* tex);
+
+    void clear(const SKcolor4b& col) const;
+
+    void clear(const SKcolor4b& col, SKint32 y1, SKint32 y2) const;
+
+    void blendSpan(SKint32 y, SKint32 x1, SKint32 x2, const SKcolor4b& col) const;
+
+    void blendPixel(SKint32 x, SKint32 y, const SKcolor4b& col) const;
+
+    void sample(skScalar u, skScalar v, SKcolor4b& col) const;
+
+    void readSpan(SKint32 y, SKint32 x1, SKint32 x2, SKubyte* dest) const;
+
+    bool isValid(void) const
+    {
+        return m_bits != nullptr;
+    }
+
+    SKint32 getWidth(void) const
+    {
+        return m_width;
+    }
+
+    SKint32 getHeight(void) const
+    {
+        return m_height;
+    }
+
+    static void getLayout(SKpixelFormat fmt, SKsoftwareLayout& layout);
+
+private:
+    SKubyte* row(SKint32 y) const
+    {
+        return m_bits + (SKsize)(m_layout.flipped ? m_height - 1 - y : y) * m_pitch;
+    }
+
+    void blend(SKubyte* dst, const SKcolor4b& col) const;
+};
+
+#endif  //_skSoftwareSurface_h_
@@ -0,0 +1,130 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "Software/skSoftwareWorkers.h"
+
+skSoftwareWorkers::skSoftwareWorkers() :
+    m_next(0),
+    m_task(nullptr),
+    m_user(nullptr),
+    m_count(0),
+    m_busy(0),
+    m_job(0),
+    m_quit(false)
+{
+}
+
+skSoftwareWorkers::~skSoftwareWorkers()
+{
+    stop();
+}
+
+void skSoftwareWorkers::stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+
+    for (SKuint32 i = 0; i < m_threads.size(); ++i)
+    {
+        m_threads[i]->join();
+        delete m_threads[i];
+    }
+
+    m_threads.resizeFast(0);
+    m_quit = false;
+}
+
+void skSoftwareWorkers::setThreadCount(SKuint32 nr)
+{
+    if (nr < 1)
+        nr = 1;
+    if (nr == getThreadCount())
+        return;
+
+    stop();
+
+    for (SKuint32 i = 1; i < nr; ++i)
+        m_threads.push_back(new std::thread(&skSoftwareWorkers::main, this, i, m_job));
+}
+
+void skSoftwareWorkers::run(SKsoftwareTask task, void* user, SKuint32 count)
+{
+    if (!task || count == 0)
+        return;
+
+    if (m_threads.empty())
+    {
+        for (SKuint32 i = 0; i < count; ++i)
+            task(user, 0, i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_task  = task;
+        m_user  = user;
+        m_count = count;
+        m_busy  = m_threads.size();
+        m_next.store(0);
+        ++m_job;
+    }
+    m_wake.notify_all();
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_busy == 0; });
+    m_task = nullptr;
+}
+
+void skSoftwareWorkers::work(SKuint32 worker)
+{
+    SKuint32 index;
+    while ((index = m_next.fetch_add(1)) < m_count)
+        m_task(m_user, worker, index);
+}
+
+void skSoftwareWorkers::main(SKuint32 worker, SKuint32 job)
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, job] { return m_quit || m_job != job; });
+
+            if (m_quit)
+                return;
+            job = m_job;
+        }
+
+        work(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_busy == 0)
+                m_done.notify_one();
+        }
+    }
+}
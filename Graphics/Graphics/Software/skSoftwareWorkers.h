@@ -0,0 +1,74 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skSoftwareWorkers_h_
+#define _skSoftwareWorkers_h_
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "Utils/Config/skConfig.h"
+#include "Utils/skArray.h"
+
+typedef void (*SKsoftwareTask)(void* user, SKuint32 worker, SKuint32 index);
+
+class skSoftwareWorkers
+{
+private:
+    skArray<std::thread*>   m_threads;
+    std::mutex              m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    std::atomic<SKuint32>   m_next;
+    SKsoftwareTask          m_task;
+    void*                   m_user;
+    SKuint32                m_count;
+    SKuint32                m_busy;
+    SKuint32                m_job;
+    bool                    m_quit;
+
+public:
+    skSoftwareWorkers();
+    ~skSoftwareWorkers();
+
+    // The calling thread counts as a worker, so
+    // nr - 1 threads are started.
+    void setThreadCount(SKuint32 nr);
+
+    // Calls task for every index in [0, count) and
+    // returns once all of them have completed.
+    void run(SKsoftwareTask task, void* user, SKuint32 count);
+
+    SKuint32 getThreadCount(void) const
+    {
+        return m_threads.size() + 1;
+    }
+
+private:
+    void stop(void);
+
+    void main(SKuint32 worker, SKuint32 job);
+
+    void work(SKuint32 worker);
+};
+
+#endif  //_skSoftwareWorkers_h_
@@ -25,6 +25,7 @@
 #include "Graphics/skGraphics.h"
 #include "Math/skBoundingBox2D.h"
 #include "skCachedString.h"
+#include "skDisplayList.h"
 #include "skContext.h"
 #include "skFont.h"
 #include "skPaint.h"
@@ -32,7 +33,9 @@
 #include "skTexture.h"
 #include "Math/skQuaternion.h"
 
-static SKcontext g_currentContext;
+// Each thread selects its own context, so separate
+// threads can drive separate contexts in parallel.
+static thread_local SKcontext g_currentContext = nullptr;
 
 /**********************************************************
     Startup / Shutdown
@@ -58,6 +61,7 @@ SK_API void skDeleteContext(SKcontext ctx)
     if (!context)
         return;
 
+    // only the calling thread's selection can be cleared
     if (ctx == g_currentContext)
         g_currentContext = nullptr;
 
@@ -75,6 +79,14 @@ SK_API void skSetCurrentContext(SKcontext ctx)
         g_currentContext = ctx;
 }
 
+SK_API SKimage skGetContextImage()
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, nullptr);
+
+    return ctx->getContextImage();
+}
+
 SK_API void skContextSize(SKscalar w, SKscalar h)
 {
     skContext* ctx = SK_CURRENT_CTX();
@@ -94,7 +106,12 @@ SK_API void skClearContext()
 SK_API void skSetContext1i(SKcontextOptionEnum en,
                            SKint32             v)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skSetContext1iEx(g_currentContext, en, v);
+}
+
+SK_API void skSetContext1iEx(SKcontext context, SKcontextOptionEnum en, SKint32 v)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->setContextI(en, v);
@@ -103,14 +120,24 @@ SK_API void skSetContext1i(SKcontextOptionEnum en,
 SK_API void skSetContext1f(SKcontextOptionEnum en,
                            SKscalar            v)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skSetContext1fEx(g_currentContext, en, v);
+}
+
+SK_API void skSetContext1fEx(SKcontext context, SKcontextOptionEnum en, SKscalar v)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
     ctx->setContextF(en, v);
 }
 
 SK_API void skGetContext1i(const SKcontextOptionEnum en, SKint32* v)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skGetContext1iEx(g_currentContext, en, v);
+}
+
+SK_API void skGetContext1iEx(SKcontext context, SKcontextOptionEnum en, SKint32* v)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
     SK_CHECK_PARAM(v, SK_RETURN_VOID);
 
@@ -161,7 +188,17 @@ SK_API void skSetContext2f(SKcontextOptionEnum en,
                            SKscalar            f0,
                            SKscalar            f1)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skSetContext2fEx(g_currentContext, en, f0, f1);
+}
+
+SK_API void skSetContext2iEx(SKcontext context, SKcontextOptionEnum en, SKint32 i0, SKint32 i1)
+{
+    skSetContext2fEx(context, en, (SKscalar)i0, (SKscalar)i1);
+}
+
+SK_API void skSetContext2fEx(SKcontext context, SKcontextOptionEnum en, SKscalar f0, SKscalar f1)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->setContextV(en, skVector2(f0, f1));
@@ -206,7 +243,12 @@ SK_API SKpath skGetWorkingPath()
 
 SK_API void skLoadIdentity()
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skLoadIdentityEx(g_currentContext);
+}
+
+SK_API void skLoadIdentityEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->getMatrix()
@@ -215,7 +257,12 @@ SK_API void skLoadIdentity()
 
 SK_API void skTranslate(SKscalar x, SKscalar y)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skTranslateEx(g_currentContext, x, y);
+}
+
+SK_API void skTranslateEx(SKcontext context, SKscalar x, SKscalar y)
+{
+    skContext* ctx = SK_CAST_CTX(context);
 
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
@@ -276,16 +323,52 @@ SK_API void skClearColor1i(SKcolori rgba)
 
 SK_API void skClear(SKscalar x, SKscalar y, SKscalar w, SKscalar h)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skClearEx(g_currentContext, x, y, w, h);
+}
+
+SK_API void skClearEx(SKcontext context, SKscalar x, SKscalar y, SKscalar w, SKscalar h)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->setContextR(SK_CLEAR_RECT, skRectangle(x, y, w, h));
     ctx->clear();
 }
 
+SK_API void skFlush()
+{
+    skFlushEx(g_currentContext);
+}
+
+SK_API void skFlushEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->flush();
+}
+
+SK_API void skInvalidateState()
+{
+    skInvalidateStateEx(g_currentContext);
+}
+
+SK_API void skInvalidateStateEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->invalidateState();
+}
+
 SK_API void skProjectContext(SKprojectionType pt)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skProjectContextEx(g_currentContext, pt);
+}
+
+SK_API void skProjectContextEx(SKcontext context, SKprojectionType pt)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->projectContext(pt);
@@ -321,7 +404,12 @@ SK_API void skDeletePaint(SKpaint obj)
 
 SK_API void skSelectPaint(SKpaint obj)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skSelectPaintEx(g_currentContext, obj);
+}
+
+SK_API void skSelectPaintEx(SKcontext context, SKpaint obj)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->selectPaint((skPaint*)obj);
@@ -329,7 +417,12 @@ SK_API void skSelectPaint(SKpaint obj)
 
 SK_API void skColor1ui(SKuint32 c)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skColor1uiEx(g_currentContext, c);
+}
+
+SK_API void skColor1uiEx(SKcontext context, SKuint32 c)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->setPaintC(SK_SURFACE_COLOR, skColor(c));
@@ -345,7 +438,12 @@ SK_API void skColor3f(SKscalar r, SKscalar g, SKscalar b)
 
 SK_API void skColor4f(SKscalar r, SKscalar g, SKscalar b, SKscalar a)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skColor4fEx(g_currentContext, r, g, b, a);
+}
+
+SK_API void skColor4fEx(SKcontext context, SKscalar r, SKscalar g, SKscalar b, SKscalar a)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->setPaintC(SK_SURFACE_COLOR, skColor(r, g, b, a));
@@ -434,9 +532,29 @@ SK_API void skGetPaint1ui(SKpaintStyle en, SKuint32* v)
     *v = ctx->getPaintC(en);
 }
 
+SK_API void skSetPaintDashes(const SKscalar* pattern, SKint32 count)
+{
+    skSetPaintDashesEx(g_currentContext, pattern, count);
+}
+
+SK_API void skSetPaintDashesEx(SKcontext context, const SKscalar* pattern, SKint32 count)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(count >= 0, SK_RETURN_VOID);
+    SK_CHECK_PARAM(pattern || count == 0, SK_RETURN_VOID);
+
+    ctx->setPaintDashes(pattern, (SKuint32)count);
+}
+
 SK_API SKimage skNewImage()
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    return skNewImageEx(g_currentContext);
+}
+
+SK_API SKimage skNewImageEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, nullptr);
 
     return ctx->newImage();
@@ -451,6 +569,38 @@ SK_API SKimage skCreateImage(SKuint32 w, SKuint32 h, SKint32 format)
     return ctx->createImage(w, h, (SKpixelFormat)format);
 }
 
+SK_API SKimage skNewRenderTarget(SKuint32 w, SKuint32 h, SKint32 format)
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, nullptr);
+    SK_CHECK_PARAM(w > 0 && h > 0, nullptr);
+    SK_CHECK_PARAM(format >= 0 && format < SK_PF_MAX, nullptr);
+
+    return ctx->newRenderTarget(w, h, (SKpixelFormat)format);
+}
+
+SK_API void skBindRenderTarget(SKimage ima)
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->bindRenderTarget(ima);
+}
+
+SK_API void skReadPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* pixels)
+{
+    skReadPixelsEx(g_currentContext, x, y, w, h, pixels);
+}
+
+SK_API void skReadPixelsEx(SKcontext context, SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* pixels)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(pixels, SK_RETURN_VOID);
+
+    ctx->readPixels(x, y, w, h, pixels);
+}
+
 SK_API void skImageLinearGradient(SKimage      ima,
                                   SKcolorStop* stops,
                                   SKint32      stopCount,
@@ -508,10 +658,15 @@ SK_API void skImageRadialGradientEx(SKimage      ima,
 
 SK_API void skImageSave(SKimage ima, const char* path)
 {
-    skTexture* img = SKcheckType<skTexture, SKimage, skContext>(ima, SK_CURRENT_CTX());
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    skTexture* img = SKcheckType<skTexture, SKimage, skContext>(ima, ctx);
     SK_CHECK_PARAM(img, SK_RETURN_VOID);
     SK_CHECK_PARAM(path, SK_RETURN_VOID);
 
+    ctx->resolveImage(img);
+
     img->save(path);
 }
 
@@ -529,7 +684,12 @@ SK_API SKimage skImageLoad(const char* path)
 
 SK_API void skDeleteImage(SKimage ima)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skDeleteImageEx(g_currentContext, ima);
+}
+
+SK_API void skDeleteImageEx(SKcontext context, SKimage ima)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->deleteImage(ima);
@@ -562,7 +722,12 @@ SK_API void skGetImage1i(SKimage image, SKimageOptionEnum en, SKint32* v)
 
 SK_API SKfont skNewFont(SKbuiltinFont font, SKuint32 size, SKuint32 dpi)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    return skNewFontEx(g_currentContext, font, size, dpi);
+}
+
+SK_API SKfont skNewFontEx(SKcontext context, SKbuiltinFont font, SKuint32 size, SKuint32 dpi)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, nullptr);
     return ctx->newFont(font, size, dpi);
 }
@@ -584,7 +749,12 @@ SK_API SKfont skNewFontFromFile(const char* path, SKuint32 size, SKuint32 dpi)
 
 SK_API void skDeleteFont(SKfont font)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skDeleteFontEx(g_currentContext, font);
+}
+
+SK_API void skDeleteFontEx(SKcontext context, SKfont font)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
     ctx->deleteFont(font);
 }
@@ -633,7 +803,12 @@ SK_API void skGetFontCharExtentEx(SKfont font, char ch, SKtextExtent* te)
 
 SK_API void skDisplayString(SKfont font, const char* str, SKint32 len, SKscalar x, SKscalar y)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skDisplayStringEx(g_currentContext, font, str, len, x, y);
+}
+
+SK_API void skDisplayStringEx(SKcontext context, SKfont font, const char* str, SKint32 len, SKscalar x, SKscalar y)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
     SK_CHECK_PARAM(font, SK_RETURN_VOID);
     SK_CHECK_PARAM(str, SK_RETURN_VOID);
@@ -646,7 +821,7 @@ SK_API void skDisplayString(SKfont font, const char* str, SKint32 len, SKscalar
 
 SK_API void skDisplayFormattedString(SKfont font, SKscalar x, SKscalar y, const char* str, ...)
 {
-    static char buffer[1025];
+    static thread_local char buffer[1025];
 
     SK_CHECK_PARAM(font, SK_RETURN_VOID);
     SK_CHECK_PARAM(str, SK_RETURN_VOID);
@@ -758,7 +933,12 @@ SK_API void skGetPathBoundingBox(SKaabbf* bb)
 
 SK_API void skMoveTo(SKscalar x, SKscalar y)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skMoveToEx(g_currentContext, x, y);
+}
+
+SK_API void skMoveToEx(SKcontext context, SKscalar x, SKscalar y)
+{
+    skContext* ctx = SK_CAST_CTX(context);
 
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
@@ -768,7 +948,12 @@ SK_API void skMoveTo(SKscalar x, SKscalar y)
 
 SK_API void skLineTo(SKscalar x, SKscalar y)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skLineToEx(g_currentContext, x, y);
+}
+
+SK_API void skLineToEx(SKcontext context, SKscalar x, SKscalar y)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->getWorkPath()
@@ -785,13 +970,52 @@ SK_API void skPutVert(SKscalar x, SKscalar y, SKuint8 move)
 
 SK_API void skCubicTo(SKscalar fx, SKscalar fy, SKscalar tx, SKscalar ty)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skCubicToEx(g_currentContext, fx, fy, tx, ty);
+}
+
+SK_API void skCubicToEx(SKcontext context, SKscalar fx, SKscalar fy, SKscalar tx, SKscalar ty)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->getWorkPath()
         .cubicTo(fx, fy, tx, ty);
 }
 
+SK_API void skQuadTo(SKscalar cx, SKscalar cy, SKscalar x, SKscalar y)
+{
+    skQuadToEx(g_currentContext, cx, cy, x, y);
+}
+
+SK_API void skQuadToEx(SKcontext context, SKscalar cx, SKscalar cy, SKscalar x, SKscalar y)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->getWorkPath()
+        .quadTo(cx, cy, x, y);
+}
+
+SK_API void skBezierTo(SKscalar c1x, SKscalar c1y, SKscalar c2x, SKscalar c2y, SKscalar x, SKscalar y)
+{
+    skBezierToEx(g_currentContext, c1x, c1y, c2x, c2y, x, y);
+}
+
+SK_API void skBezierToEx(SKcontext context,
+                         SKscalar  c1x,
+                         SKscalar  c1y,
+                         SKscalar  c2x,
+                         SKscalar  c2y,
+                         SKscalar  x,
+                         SKscalar  y)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->getWorkPath()
+        .bezierTo(c1x, c1y, c2x, c2y, x, y);
+}
+
 SK_API void skRectTo(SKscalar fx, SKscalar fy, SKscalar tx, SKscalar ty)
 {
     skContext* ctx = SK_CURRENT_CTX();
@@ -826,7 +1050,12 @@ SK_API void skArc(SKscalar x, SKscalar y, SKscalar radius, SKscalar angle1, SKsc
 
 SK_API void skClosePath()
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skClosePathEx(g_currentContext);
+}
+
+SK_API void skClosePathEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->getWorkPath()
@@ -835,16 +1064,53 @@ SK_API void skClosePath()
 
 SK_API void skClearPath()
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skClearPathEx(g_currentContext);
+}
+
+SK_API void skClearPathEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->getWorkPath()
         .clear();
 }
 
+SK_API void skPathAppend(const SKscalar* xy, SKuint32 count, SKuint32 flags)
+{
+    skPathAppendEx(g_currentContext, xy, count, flags);
+}
+
+SK_API void skPathAppendEx(SKcontext context, const SKscalar* xy, SKuint32 count, SKuint32 flags)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(xy, SK_RETURN_VOID);
+
+    ctx->getWorkPath().appendVertices(xy, count, flags);
+}
+
+SK_API void skPathSimplify(SKsimplifyMode mode, SKscalar tolerance)
+{
+    skPathSimplifyEx(g_currentContext, mode, tolerance);
+}
+
+SK_API void skPathSimplifyEx(SKcontext context, SKsimplifyMode mode, SKscalar tolerance)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->getWorkPath().setSimplify(mode, tolerance);
+}
+
 SK_API void skRect(SKscalar x, SKscalar y, SKscalar w, SKscalar h)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skRectEx(g_currentContext, x, y, w, h);
+}
+
+SK_API void skRectEx(SKcontext context, SKscalar x, SKscalar y, SKscalar w, SKscalar h)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     skPath& pth = ctx->getWorkPath();
@@ -864,7 +1130,12 @@ SK_API void skLine(SKscalar x1, SKscalar y1, SKscalar x2, SKscalar y2)
 
 SK_API void skEllipse(SKscalar x, SKscalar y, SKscalar w, SKscalar h)
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skEllipseEx(g_currentContext, x, y, w, h);
+}
+
+SK_API void skEllipseEx(SKcontext context, SKscalar x, SKscalar y, SKscalar w, SKscalar h)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     skPath& pth = ctx->getWorkPath();
@@ -900,15 +1171,44 @@ SK_API void skPolygon(SKscalar* vertices, SKuint32 count, SKuint32 close)
 
 SK_API void skFill()
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skFillEx(g_currentContext);
+}
+
+SK_API void skFillEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->fill();
 }
 
+SK_API void skFillInstanced(SKpath path, const SKscalar* transforms, const SKcolori* colors, SKuint32 count)
+{
+    skFillInstancedEx(g_currentContext, path, transforms, colors, count);
+}
+
+SK_API void skFillInstancedEx(SKcontext       context,
+                              SKpath          path,
+                              const SKscalar* transforms,
+                              const SKcolori* colors,
+                              SKuint32        count)
+{
+    skContext* ctx = SK_CAST_CTX(context);
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(path, SK_RETURN_VOID);
+    SK_CHECK_PARAM(transforms || count == 0, SK_RETURN_VOID);
+
+    ctx->fillInstanced((skPath*)path, transforms, colors, count);
+}
+
 SK_API void skStroke()
 {
-    skContext* ctx = SK_CURRENT_CTX();
+    skStrokeEx(g_currentContext);
+}
+
+SK_API void skStrokeEx(SKcontext context)
+{
+    skContext* ctx = SK_CAST_CTX(context);
     SK_CHECK_CTX(ctx, SK_RETURN_VOID);
 
     ctx->stroke();
@@ -973,3 +1273,37 @@ SK_API void skGetCachedString2fv(const SKcachedString str, SKstringOptionEnum en
     v[0] = vec.x;
     v[1] = vec.y;
 }
+
+SK_API void skBeginList()
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+
+    ctx->beginList();
+}
+
+SK_API SKlist skEndList()
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, nullptr);
+
+    return ctx->endList();
+}
+
+SK_API void skCallList(SKlist list)
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(list, SK_RETURN_VOID);
+
+    ctx->callList(list);
+}
+
+SK_API void skDeleteList(SKlist list)
+{
+    skContext* ctx = SK_CURRENT_CTX();
+    SK_CHECK_CTX(ctx, SK_RETURN_VOID);
+    SK_CHECK_PARAM(list, SK_RETURN_VOID);
+
+    ctx->deleteList(list);
+}
@@ -0,0 +1,122 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skBatchList_h_
+#define _skBatchList_h_
+
+#include "Math/skBoundingBox2D.h"
+#include "Utils/skArray.h"
+
+// A run of queued draws that go out as one, linked
+// from head to tail through each command's next.
+typedef struct SKbatchList
+{
+    SKint32         head;
+    SKint32         tail;
+    skBoundingBox2D bounds;
+    SKuint32        first;
+    SKuint32        count;
+    SKuint32        firstIndex;
+    SKuint32        indexCount;
+} SKbatchList;
+
+inline bool skBatchIntersects(const skBoundingBox2D& a, const skBoundingBox2D& b)
+{
+    return a.x1 <= b.x2 && b.x1 <= a.x2 && a.y1 <= b.y2 && b.y1 <= a.y2;
+}
+
+// True when anything already in the batch touches the bounds.
+template <typename Command>
+bool skBatchOverlaps(const skArray<Command>& queue,
+                     const SKbatchList&      batch,
+                     const skBoundingBox2D&  bounds)
+{
+    if (!skBatchIntersects(batch.bounds, bounds))
+        return false;
+
+    for (SKint32 i = batch.head; i != -1; i = queue[i].next)
+    {
+        if (skBatchIntersects(queue[i].bounds, bounds))
+            return true;
+    }
+    return false;
+}
+
+// Groups the queued commands into batches, in draw order. A command
+// joins the most recent of the last lookback batches that shares its
+// state, as long as it does not overlap anything drawn between that
+// batch and its own place. A lookback of one only joins neighbours.
+// Commands need bounds and a next link, which is set here.
+template <typename Command>
+void skSortBatches(skArray<Command>&    queue,
+                   skArray<SKbatchList>& batches,
+                   SKuint32              lookback,
+                   bool (*sameState)(const Command& a, const Command& b))
+{
+    batches.resizeFast(0);
+
+    const SKuint32 nrCmd = queue.size();
+    for (SKuint32 c = 0; c < nrCmd; ++c)
+    {
+        Command& cmd = queue[c];
+        cmd.next     = -1;
+
+        SKint32        target = -1;
+        const SKuint32 nr     = batches.size();
+
+        for (SKuint32 k = 0; k < lookback && k < nr; ++k)
+        {
+            const SKbatchList& batch = batches[nr - 1 - k];
+            if (sameState(queue[batch.head], cmd))
+            {
+                target = (SKint32)(nr - 1 - k);
+                break;
+            }
+
+            if (skBatchOverlaps(queue, batch, cmd.bounds))
+                break;
+        }
+
+        if (target == -1)
+        {
+            SKbatchList batch;
+            batch.head       = (SKint32)c;
+            batch.tail       = (SKint32)c;
+            batch.bounds     = cmd.bounds;
+            batch.first      = 0;
+            batch.count      = 0;
+            batch.firstIndex = 0;
+            batch.indexCount = 0;
+            batches.push_back(batch);
+        }
+        else
+        {
+            SKbatchList& batch = batches[target];
+
+            queue[batch.tail].next = (SKint32)c;
+            batch.tail             = (SKint32)c;
+            batch.bounds.compare(cmd.bounds.x1, cmd.bounds.y1);
+            batch.bounds.compare(cmd.bounds.x2, cmd.bounds.y2);
+        }
+    }
+}
+
+#endif  //_skBatchList_h_
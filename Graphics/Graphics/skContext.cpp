@@ -20,6 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #include "skContext.h"
+#include <atomic>
 #include <cstdio>
 
 #ifdef Graphics_BACKEND_OPENGL
@@ -29,10 +30,16 @@
 #include "Window/OpenGL/skOpenGL.h"
 #endif
 
+#ifdef Graphics_BACKEND_SOFTWARE
+#include "Software/skSoftwareRenderer.h"
+#endif
+
 #include "Utils/skDisableWarnings.h"
 #include "Utils/skLogger.h"
 #include "skCachedString.h"
+#include "skDisplayList.h"
 #include "skFont.h"
+#include "skLibrary.h"
 #include "skPaint.h"
 #include "skPath.h"
 #include "skRender.h"
@@ -40,11 +47,11 @@
 
 skContext::skContext(SKint32 backend)
 {
-    static SKint32 _ctxHandle = 0;
-    skImage::initialize();
+    static std::atomic<SKint32> _ctxHandle(0);
+    skLibrary::initialize();
 
     m_renderContext = nullptr;
-    m_id            = _ctxHandle++;
+    m_id            = _ctxHandle.fetch_add(1);
     m_backend       = backend;
 
     // not owned by the user
@@ -57,6 +64,9 @@ skContext::skContext(SKint32 backend)
     m_tempPath  = nullptr;
     m_workFont  = nullptr;
 
+    m_renderTarget = nullptr;
+    m_list         = nullptr;
+
     m_matrix.makeIdentity();
     m_options.verticesPerSegment = SK_DEFAULT_VERTICES_PER_SEGMENT;
     m_options.clearColor         = skColor(0, 0, 0, 1);
@@ -69,15 +79,28 @@ skContext::skContext(SKint32 backend)
     m_options.currentViewport    = 0;
     m_options.projectionType     = SK_DEFAULT_PROJECTION_MODE;
     m_options.yIsUp              = false;
+    m_options.workerThreads      = SK_DEFAULT_WORKER_THREADS;
+    m_options.antiAlias          = 0;
+    m_options.batchDraws         = 0;
+    m_options.reorderDraws       = 0;
+    m_options.flattenTolerance   = 0;
 
 #ifdef Graphics_BACKEND_OPENGL
     if (m_backend == SK_BE_OpenGL)
         makeCurrent(new skOpenGLRenderer());
 #endif
+
+#ifdef Graphics_BACKEND_SOFTWARE
+    if (m_backend == SK_BE_Software)
+        makeCurrent(new skSoftwareRenderer());
+#endif
 }
 
 skContext::~skContext()
 {
+    // draw anything still queued before the renderer goes
+    flush();
+
     if (m_tempPaint)
         selectPaint(nullptr);
     delete m_workPaint;
@@ -86,9 +109,12 @@ skContext::~skContext()
         selectPath(nullptr);
     delete m_workPath;
 
+    delete m_list;
+    for (SKuint32 i = 0; i < m_lists.size(); ++i)
+        delete m_lists[i];
     delete m_renderContext;
 
-    skImage::finalize();
+    skLibrary::finalize();
 }
 
 void skContext::makeCurrent(skRenderer* ctx)
@@ -113,7 +139,7 @@ SKimage skContext::createImage(SKuint32 w, SKuint32 h, SKpixelFormat fmt)
 #endif
     }
 
-    if (m_backend == SK_BE_None)
+    if (m_backend == SK_BE_None || m_backend == SK_BE_Software)
     {
         skTexture* tex = new skTexture(w, h, fmt);
         tex->setContext(this);
@@ -133,7 +159,7 @@ SKimage skContext::newImage()
 #endif
     }
 
-    if (m_backend == SK_BE_None)
+    if (m_backend == SK_BE_None || m_backend == SK_BE_Software)
     {
         skTexture* tex = new skTexture();
 
@@ -146,6 +172,12 @@ SKimage skContext::newImage()
 
 void skContext::displayString(skCachedString* str) const
 {
+    if (m_list && str)
+    {
+        m_list->record(SK_LIST_STRING, *str->getPath(), *m_workPaint, m_workFont);
+        return;
+    }
+
     if (m_renderContext && str)
     {
         m_renderContext->selectPaint(m_workPaint);
@@ -166,7 +198,7 @@ skTexture* skContext::createInternalImage(SKuint32 w, SKuint32 h, SKpixelFormat
 #endif
     }
 
-    if (m_backend == SK_BE_None)
+    if (m_backend == SK_BE_None || m_backend == SK_BE_Software)
     {
         skTexture* tex = new skTexture(w, h, fmt);
 
@@ -185,9 +217,92 @@ void skContext::deleteImage(SKimage ima)
     if (!img || img->getContext() != this)
         return;
 
+    // the render target is owned by the renderer
+    if (m_renderContext && m_renderContext->getTarget() == img)
+        return;
+
+    if (img == m_renderTarget)
+        bindRenderTarget(nullptr);
+
+    // pending draws may still sample it
+    flush();
+
+    skTexture* pattern = nullptr;
+    m_workPaint->getT(SK_BRUSH_PATTERN, &pattern);
+    if (pattern == img)
+        m_workPaint->setT(SK_BRUSH_PATTERN, nullptr);
+
+    releaseFromLists(nullptr, img);
     delete img;
 }
 
+SKimage skContext::getContextImage(void) const
+{
+    if (m_renderContext)
+        return SK_IMAGE_HANDLE(m_renderContext->getTarget());
+    return nullptr;
+}
+
+SKimage skContext::newRenderTarget(SKuint32 w, SKuint32 h, SKpixelFormat fmt)
+{
+    // there is nothing to draw with
+    if (!m_renderContext)
+        return nullptr;
+
+    skTexture* tex = SK_TEXTURE(createImage(w, h, fmt));
+    if (tex && tex->getBPP() < 3)
+    {
+        skLogd(LD_ERROR, "Render targets need an RGB or RGBA pixel format\n");
+        delete tex;
+        tex = nullptr;
+    }
+    return SK_IMAGE_HANDLE(tex);
+}
+
+void skContext::bindRenderTarget(SKimage ima)
+{
+    skTexture* img = SK_TEXTURE(ima);
+    if (img && img->getContext() != this)
+        return;
+
+    if (!m_renderContext || img == m_renderTarget)
+        return;
+
+    flush();
+    m_renderContext->bindTarget(img);
+    m_renderTarget = img;
+
+    // The renderer views the whole target and puts the context's
+    // view back on unbind. The projection keeps the context's axes.
+    if (img)
+    {
+        const skScalar w = (skScalar)img->getWidth();
+        const skScalar h = (skScalar)img->getHeight();
+
+        if (m_options.yIsUp)
+            projectBox(-w * .5f, -h * .5f, w * .5f, h * .5f);
+        else
+            projectRect(0, 0, w, h);
+    }
+}
+
+void skContext::resolveImage(skTexture* img) const
+{
+    flush();
+
+    if (m_renderContext && img)
+        m_renderContext->resolveTarget(img);
+}
+
+void skContext::readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest) const
+{
+    if (m_renderContext)
+    {
+        flush();
+        m_renderContext->readPixels(x, y, w, h, dest);
+    }
+}
+
 void skContext::selectImage(SKimage ima)
 {
     if (m_workPaint)
@@ -247,6 +362,13 @@ void skContext::deleteFont(SKfont font)
     skFont* fnt = SK_FONT(font);
     if (!fnt || fnt->getContext() != this)
         return;
+
+    flush();
+
+    if (m_workFont == fnt)
+        m_workFont = nullptr;
+
+    releaseFromLists(fnt, nullptr);
     delete fnt;
 }
 
@@ -258,12 +380,86 @@ void skContext::displayString(SKfont font, const char* str, SKuint32 len, skScal
         if (!fnt || fnt->getContext() != this)
             return;
 
+        if (m_list)
+        {
+            skPath path;
+            fnt->buildPath(&path, str, len, x, y);
+            m_list->record(SK_LIST_STRING, path, *m_workPaint, fnt);
+            return;
+        }
+
         m_renderContext->selectPaint(m_workPaint);
         m_renderContext->displayString(fnt, str, len, x, y);
         m_renderContext->selectPaint(nullptr);
     }
 }
 
+void skContext::beginList(void)
+{
+    if (!m_renderContext)
+        return;
+
+    if (m_list)
+    {
+        skLogd(LD_WARN, "A display list is already being recorded\n");
+        return;
+    }
+
+    m_list = new skDisplayList();
+    m_list->setContext(this);
+}
+
+SKlist skContext::endList(void)
+{
+    skDisplayList* list = m_list;
+    m_list              = nullptr;
+
+    // the context owns it until it is deleted
+    if (list)
+        m_lists.push_back(list);
+    return SK_LIST_HANDLE(list);
+}
+
+void skContext::callList(SKlist list) const
+{
+    const skDisplayList* dl = SK_LIST(list);
+    if (!dl || dl->getContext() != this)
+        return;
+
+    if (m_list)
+        m_list->append(*dl);
+    else
+        dl->call(m_renderContext);
+}
+
+void skContext::deleteList(SKlist list)
+{
+    skDisplayList* dl = SK_LIST(list);
+    if (!dl || dl->getContext() != this || dl == m_list)
+        return;
+
+    for (SKuint32 i = 0; i < m_lists.size(); ++i)
+    {
+        if (m_lists[i] == dl)
+        {
+            m_lists[i] = m_lists[m_lists.size() - 1];
+            m_lists.resizeFast(m_lists.size() - 1);
+
+            delete dl;
+            return;
+        }
+    }
+}
+
+void skContext::releaseFromLists(const skFont* font, const skTexture* image) const
+{
+    if (m_list)
+        m_list->release(font, image);
+
+    for (SKuint32 i = 0; i < m_lists.size(); ++i)
+        m_lists[i]->release(font, image);
+}
+
 void skContext::projectContext(SKprojectionType pt)
 {
     if (pt == SK_CARTESIAN)
@@ -311,6 +507,18 @@ void skContext::clearContext(void) const
         m_renderContext->clear();
 }
 
+void skContext::flush(void) const
+{
+    if (m_renderContext)
+        m_renderContext->flush();
+}
+
+void skContext::invalidateState(void) const
+{
+    if (m_renderContext)
+        m_renderContext->invalidateState();
+}
+
 void skContext::clear(void) const
 {
     if (m_renderContext)
@@ -363,7 +571,14 @@ void skContext::selectPaint(skPaint* obj)
 
 void skContext::fill(void) const
 {
-    if (m_renderContext)
+    if (m_list)
+    {
+        m_list->record(SK_LIST_FILL, *m_workPath, *m_workPaint, nullptr);
+
+        if (m_workPaint->autoClear())
+            m_workPath->clear();
+    }
+    else if (m_renderContext)
     {
         m_renderContext->selectPaint(m_workPaint);
         m_renderContext->fill(m_workPath);
@@ -375,9 +590,58 @@ void skContext::fill(void) const
     }
 }
 
+void skContext::fillInstanced(skPath*         path,
+                              const skScalar* transforms,
+                              const SKuint32* colors,
+                              SKuint32        count)
+{
+    if (!m_list && m_renderContext)
+    {
+        m_renderContext->selectPaint(m_workPaint);
+        const bool drawn = m_renderContext->fillInstanced(path, transforms, colors, count);
+        m_renderContext->selectPaint(nullptr);
+
+        if (drawn)
+            return;
+    }
+
+    // one fill per instance
+    skPath instance;
+    instance.setContext(this);
+
+    SKuint32 surface;
+    m_workPaint->getC(SK_SURFACE_COLOR, &surface);
+
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        instance.copy(*path);
+        instance.transform(transforms + i * 6);
+
+        if (colors)
+            m_workPaint->setC(SK_SURFACE_COLOR, skColor(colors[i]));
+
+        if (m_list)
+            m_list->record(SK_LIST_FILL, instance, *m_workPaint, nullptr);
+        else if (m_renderContext)
+        {
+            m_renderContext->selectPaint(m_workPaint);
+            m_renderContext->fill(&instance);
+            m_renderContext->selectPaint(nullptr);
+        }
+    }
+    m_workPaint->setC(SK_SURFACE_COLOR, skColor(surface));
+}
+
 void skContext::stroke(void) const
 {
-    if (m_renderContext)
+    if (m_list)
+    {
+        m_list->record(SK_LIST_STROKE, *m_workPath, *m_workPaint, nullptr);
+
+        if (m_workPaint->autoClear())
+            m_workPath->clear();
+    }
+    else if (m_renderContext)
     {
         m_renderContext->selectPaint(m_workPaint);
         m_renderContext->stroke(m_workPath);
@@ -389,6 +653,15 @@ void skContext::stroke(void) const
     }
 }
 
+SKuint32 skContext::getStateCalls(SKcontextOptionEnum op) const
+{
+    SKuint32 issued = 0, skipped = 0;
+    if (m_renderContext)
+        m_renderContext->getStateCalls(issued, skipped);
+
+    return op == SK_STATE_CALLS_SKIPPED ? skipped : issued;
+}
+
 SKint32 skContext::getContextI(SKcontextOptionEnum op) const
 {
     switch (op)
@@ -405,6 +678,19 @@ SKint32 skContext::getContextI(SKcontextOptionEnum op) const
         return m_options.yIsUp ? 1 : 0;
     case SK_PROJECTION_TYPE:
         return m_options.projectionType;
+    case SK_WORKER_THREADS:
+        return m_options.workerThreads;
+    case SK_ANTI_ALIAS:
+        return m_options.antiAlias;
+    case SK_BATCH_DRAWS:
+        return m_options.batchDraws;
+    case SK_REORDER_DRAWS:
+        return m_options.reorderDraws;
+    case SK_FLATTEN_TOLERANCE:
+        return SKint32(m_options.flattenTolerance);
+    case SK_STATE_CALLS:
+    case SK_STATE_CALLS_SKIPPED:
+        return (SKint32)getStateCalls(op);
     //case SK_CLEAR_COLOR:
     //case SK_CLEAR_RECT:
     //case SK_CONTEXT_SIZE:
@@ -437,6 +723,27 @@ void skContext::setContextI(SKcontextOptionEnum op, SKint32 v)
     case SK_Y_UP:
         m_options.yIsUp = v != 0;
         break;
+    case SK_WORKER_THREADS:
+        m_options.workerThreads = skClamp<SKint32>(v, 1, SK_MAX_WORKER_THREADS);
+        break;
+    case SK_ANTI_ALIAS:
+        m_options.antiAlias = v ? 1 : 0;
+        break;
+    case SK_BATCH_DRAWS:
+        m_options.batchDraws = v ? 1 : 0;
+        break;
+    case SK_REORDER_DRAWS:
+        m_options.reorderDraws = v ? 1 : 0;
+        break;
+    case SK_FLATTEN_TOLERANCE:
+        m_options.flattenTolerance = skScalar(skMax<SKint32>(v, 0));
+        break;
+    case SK_STATE_CALLS:
+    case SK_STATE_CALLS_SKIPPED:
+        // the counters are read only, setting either restarts them
+        if (m_renderContext)
+            m_renderContext->resetStateCalls();
+        break;
     case SK_PROJECTION_TYPE:
         switch (v)
         {
@@ -471,6 +778,19 @@ skScalar skContext::getContextF(SKcontextOptionEnum op) const
         return m_options.currentViewport ? skScalar(1.0) : skScalar(0.0);
     case SK_Y_UP:
         return m_options.yIsUp ? skScalar(1.0) : skScalar(0.0);
+    case SK_WORKER_THREADS:
+        return skScalar(m_options.workerThreads);
+    case SK_ANTI_ALIAS:
+        return skScalar(m_options.antiAlias);
+    case SK_BATCH_DRAWS:
+        return skScalar(m_options.batchDraws);
+    case SK_REORDER_DRAWS:
+        return skScalar(m_options.reorderDraws);
+    case SK_FLATTEN_TOLERANCE:
+        return m_options.flattenTolerance;
+    case SK_STATE_CALLS:
+    case SK_STATE_CALLS_SKIPPED:
+        return skScalar(getStateCalls(op));
     default:
         break;
     }
@@ -502,6 +822,26 @@ void skContext::setContextF(SKcontextOptionEnum op, skScalar v)
     case SK_Y_UP:
         m_options.yIsUp = skIsZero(v) ? true : false;
         break;
+    case SK_WORKER_THREADS:
+        m_options.workerThreads = skClamp<SKint32>(SKint32(v), 1, SK_MAX_WORKER_THREADS);
+        break;
+    case SK_ANTI_ALIAS:
+        m_options.antiAlias = skIsZero(v) ? 0 : 1;
+        break;
+    case SK_BATCH_DRAWS:
+        m_options.batchDraws = skIsZero(v) ? 0 : 1;
+        break;
+    case SK_REORDER_DRAWS:
+        m_options.reorderDraws = skIsZero(v) ? 0 : 1;
+        break;
+    case SK_FLATTEN_TOLERANCE:
+        m_options.flattenTolerance = skMax<skScalar>(v, 0);
+        break;
+    case SK_STATE_CALLS:
+    case SK_STATE_CALLS_SKIPPED:
+        if (m_renderContext)
+            m_renderContext->resetStateCalls();
+        break;
     //case SK_CLEAR_COLOR:
     //case SK_CLEAR_RECT:
     //case SK_CONTEXT_SIZE:
@@ -652,6 +992,12 @@ SKuint32 skContext::getPaintC(SKpaintStyle op) const
     return rValue;
 }
 
+void skContext::setPaintDashes(const SKscalar* pattern, SKuint32 count) const
+{
+    if (m_workPaint)
+        m_workPaint->setDashes(pattern, count);
+}
+
 void skContext::setPaintP(SKpaintStyle op, skTexture* v) const
 {
     if (m_workPaint)
@@ -27,16 +27,19 @@
 class skContext
 {
 private:
-    skRenderer*      m_renderContext;
-    SKint32          m_id;
-    skPaint*         m_workPaint;
-    skPaint*         m_tempPaint;
-    skPath*          m_workPath;
-    skFont*          m_workFont;
-    skPath*          m_tempPath;
-    SKint32          m_backend;
-    skMatrix4        m_matrix;
-    SKcontextOptions m_options;
+    skRenderer*             m_renderContext;
+    SKint32                 m_id;
+    skPaint*                m_workPaint;
+    skPaint*                m_tempPaint;
+    skPath*                 m_workPath;
+    skFont*                 m_workFont;
+    skPath*                 m_tempPath;
+    skTexture*              m_renderTarget;
+    skDisplayList*          m_list;
+    skArray<skDisplayList*> m_lists;  // every list ended and not yet deleted
+    SKint32                 m_backend;
+    skMatrix4               m_matrix;
+    SKcontextOptions        m_options;
 
 public:
     skContext(SKint32 backend);
@@ -58,10 +61,19 @@ public:
 
     void clear(void) const;
 
+    void flush(void) const;
+
+    void invalidateState(void) const;
+
     void fill(void) const;
 
     void stroke(void) const;
 
+    void fillInstanced(skPath*         path,
+                       const skScalar* transforms,
+                       const SKuint32* colors,
+                       SKuint32        count);
+
     SKimage createImage(SKuint32 w, SKuint32 h, SKpixelFormat fmt);
 
     SKimage newImage();
@@ -70,6 +82,16 @@ public:
 
     void deleteImage(SKimage ima);
 
+    SKimage getContextImage(void) const;
+
+    SKimage newRenderTarget(SKuint32 w, SKuint32 h, SKpixelFormat fmt);
+
+    void bindRenderTarget(SKimage ima);
+
+    void resolveImage(skTexture* img) const;
+
+    void readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest) const;
+
     void selectImage(SKimage ima);
 
     SKfont newFont(SKbuiltinFont font, SKuint32 size, SKuint32 dpi);
@@ -86,6 +108,14 @@ public:
 
     void displayString(SKfont font, const char* str, SKuint32 len, skScalar x, skScalar y);
 
+    void beginList(void);
+
+    SKlist endList(void);
+
+    void callList(SKlist list) const;
+
+    void deleteList(SKlist list);
+
     void selectPath(skPath* pth);
 
     void selectPaint(skPaint* obj);
@@ -126,6 +156,8 @@ public:
 
     SKuint32 getPaintC(SKpaintStyle op) const;
 
+    void setPaintDashes(const SKscalar* pattern, SKuint32 count) const;
+
     const SKcontextOptions& getOptions(void) const;
 
     skVertexBuffer* createBuffer() const;
@@ -196,10 +228,20 @@ public:
         return m_options.verticesPerSegment;
     }
 
+    skScalar getFlattenTolerance() const
+    {
+        return m_options.flattenTolerance;
+    }
+
     bool isValid(void) const
     {
         return m_backend == SK_BE_None || m_renderContext != nullptr;
     }
+
+private:
+    SKuint32 getStateCalls(SKcontextOptionEnum op) const;
+
+    void releaseFromLists(const skFont* font, const skTexture* image) const;
 };
 
 #endif  //_skContext_h_
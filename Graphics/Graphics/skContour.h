@@ -91,6 +91,7 @@ typedef skArray<skVertexI> skPolyI;
 
 typedef skVertexT<skScalar> skVertex;
 typedef skArray<skVertex>   skPoly;
+typedef skArray<SKuint32>   skIndices;
 
 class skContour
 {
@@ -106,18 +107,58 @@ public:
     skContour& operator=(const skContour& rhs)
     {
         if (this != &rhs)
+        {
             vertices = rhs.vertices;
+            indices  = rhs.indices;
+            starts   = rhs.starts;
+            ++generation;
+        }
         return *this;
     }
 
     void push_back(const skVertex& v)
     {
         vertices.push_back(v);
+        ++generation;
     }
 
     void clear()
     {
         vertices.resizeFast(0);
+        indices.resizeFast(0);
+        starts.resizeFast(0);
+        ++generation;
+    }
+
+    // the vertices that follow start a new subpath
+    void startSubpath()
+    {
+        if (!vertices.empty())
+            starts.push_back(vertices.size());
+    }
+
+    SKuint32 subpathCount() const
+    {
+        return vertices.empty() ? 0 : starts.size() + 1;
+    }
+
+    // the range of vertices in subpath i
+    void getSubpath(SKuint32 i, SKuint32& first, SKuint32& count) const
+    {
+        first = i > 0 ? starts[i - 1] : 0;
+        count = (i < starts.size() ? starts[i] : vertices.size()) - first;
+    }
+
+    // an indexed contour is a triangle list
+    bool indexed() const
+    {
+        return !indices.empty();
+    }
+
+    // for edits made directly to the vertices
+    void touch()
+    {
+        ++generation;
     }
 
     bool empty() const
@@ -130,9 +171,10 @@ public:
         vertices.reserve(nr);
     }
 
-    skPoly vertices;
+    skPoly    vertices;
+    skIndices indices;
+    skIndices starts;  // the first vertex of every subpath after the first
+    SKuint32  generation = 0;
 };
 
-typedef skArray<skContour> skContourArray;
-
 #endif  //_skContour_h_
@@ -34,6 +34,7 @@ class skPath;
 class skTexture;
 class skFont;
 class skCachedString;
+class skDisplayList;
 class skProgram;
 class skVertexBuffer;
 
@@ -50,17 +51,24 @@ struct SKcontextOptions
     SKint32          currentViewport;
     SKprojectionType projectionType;
     bool             yIsUp;
+    SKint32          workerThreads;
+    SKint32          antiAlias;
+    SKint32          batchDraws;
+    SKint32          reorderDraws;
+    skScalar         flattenTolerance;
 };
 
 #define SK_TEXTURE(x) reinterpret_cast<skTexture*>((x))
 #define SK_FONT(x) reinterpret_cast<skFont*>((x))
 #define SK_CONTEXT(x) reinterpret_cast<skContext*>((x))
 #define SK_CSTRING(x) reinterpret_cast<skCachedString*>((x))
+#define SK_LIST(x) reinterpret_cast<skDisplayList*>((x))
 #define SK_TO_HANDLE(x, h) reinterpret_cast<h>((x))
 #define SK_IMAGE_HANDLE(x) SK_TO_HANDLE(x, SKimage)
 #define SK_FONT_HANDLE(x) SK_TO_HANDLE(x, SKfont)
 #define SK_CONTEXT_HANDLE(x) SK_TO_HANDLE(x, SKcontext)
 #define SK_CSTRING_HANDLE(x) SK_TO_HANDLE(x, SKcacheString)
+#define SK_LIST_HANDLE(x) SK_TO_HANDLE(x, SKlist)
 
 
 template <typename Ret, typename H, typename C>
@@ -0,0 +1,115 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skDisplayList.h"
+#include "skPaint.h"
+#include "skPath.h"
+#include "skRender.h"
+
+skDisplayList::~skDisplayList()
+{
+    for (SKuint32 i = 0; i < m_items.size(); ++i)
+    {
+        delete m_items[i].path;
+        delete m_items[i].paint;
+    }
+}
+
+void skDisplayList::record(SKint32 op, const skPath& path, const skPaint& paint, skFont* font)
+{
+    if (path.isEmpty())
+        return;
+
+    SKlistItem item;
+    item.op    = op;
+    item.font  = font;
+    item.paint = new skPaint(paint);
+    item.path  = new skPath();
+    item.path->setContext(m_ctx);
+    item.path->copy(path);
+
+    // Texture coordinates are generated on the first draw, so build
+    // them now and the vertices never need to be written again.
+    skTexture* pattern = nullptr;
+    item.paint->getT(SK_BRUSH_PATTERN, &pattern);
+    if (pattern && op == SK_LIST_FILL)
+        item.path->makeUV();
+
+    item.path->makeStatic();
+    m_items.push_back(item);
+}
+
+void skDisplayList::append(const skDisplayList& list)
+{
+    for (SKuint32 i = 0; i < list.m_items.size(); ++i)
+    {
+        const SKlistItem& item = list.m_items[i];
+        record(item.op, *item.path, *item.paint, item.font);
+    }
+}
+
+void skDisplayList::release(const skFont* font, const skTexture* image)
+{
+    SKuint32 kept = 0;
+    for (SKuint32 i = 0; i < m_items.size(); ++i)
+    {
+        const SKlistItem item = m_items[i];
+
+        skTexture* pattern = nullptr;
+        item.paint->getT(SK_BRUSH_PATTERN, &pattern);
+
+        if ((font && item.font == font) || (image && pattern == image))
+        {
+            delete item.path;
+            delete item.paint;
+        }
+        else
+            m_items[kept++] = item;
+    }
+    m_items.resizeFast(kept);
+}
+
+void skDisplayList::call(skRenderer* renderer) const
+{
+    SK_CHECK_PARAM(renderer, SK_RETURN_VOID);
+
+    for (SKuint32 i = 0; i < m_items.size(); ++i)
+    {
+        const SKlistItem& item = m_items[i];
+
+        renderer->selectPaint(item.paint);
+        switch (item.op)
+        {
+        case SK_LIST_FILL:
+            renderer->fill(item.path);
+            break;
+        case SK_LIST_STROKE:
+            renderer->stroke(item.path);
+            break;
+        case SK_LIST_STRING:
+            renderer->displayString(item.font, item.path);
+            break;
+        default:
+            break;
+        }
+        renderer->selectPaint(nullptr);
+    }
+}
@@ -0,0 +1,67 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skDisplayList_h_
+#define _skDisplayList_h_
+
+#include "skContextObject.h"
+
+enum SKlistOp
+{
+    SK_LIST_FILL,
+    SK_LIST_STROKE,
+    SK_LIST_STRING,
+};
+
+typedef struct SKlistItem
+{
+    SKint32  op;
+    skPath*  path;
+    skPaint* paint;
+    skFont*  font;
+} SKlistItem;
+
+class skDisplayList : public skContextObj
+{
+private:
+    skArray<SKlistItem> m_items;
+
+public:
+    skDisplayList() = default;
+    ~skDisplayList() override;
+
+    void record(SKint32 op, const skPath& path, const skPaint& paint, skFont* font);
+
+    void append(const skDisplayList& list);
+
+    void call(skRenderer* renderer) const;
+
+    // Drops every item drawn with font or image, so that
+    // neither is used once it has been deleted.
+    void release(const skFont* font, const skTexture* image);
+
+    SKuint32 size(void) const
+    {
+        return m_items.size();
+    }
+};
+
+#endif  //_skDisplayList_h_
@@ -30,6 +30,7 @@
 #include "Utils/skPlatformHeaders.h"
 #include "skContext.h"
 #include "skGlyph.h"
+#include "skLibrary.h"
 #include "skPath.h"
 #include "skTexture.h"
 #ifndef Graphics_NO_BUILTIN
@@ -363,12 +364,7 @@ void skFont::buildPath(skPath* path, const char* str, SKuint32 len, skScalar x,
                 skVertex rt(vxMax, vyMin, txMax, tyMin);
                 skVertex lb(vxMin, vyMax, txMin, tyMax);
 
-                path->addVertex(lt);
-                path->addVertex(rt);
-                path->addVertex(rb);
-                path->addVertex(rb);
-                path->addVertex(lb);
-                path->addVertex(lt);
+                path->addQuad(lt, rt, rb, lb);
             }
         }
     }
@@ -559,18 +555,11 @@ void skFont::loadGlyphs(struct FT_FaceRec_* face)
 
 bool skFont::loadTrueTypeFont(const void* mem, SKsize len, SKuint32 size, SKuint32 dpi)
 {
-    FT_Library lib;
-    FT_Face    face;
-    FT_Error   status;
+    FT_Face  face = nullptr;
+    FT_Error status;
 
-    if ((status = FT_Init_FreeType(&lib)) != 0)
-    {
-        skLogd(LD_ERROR, "FreeType initialization failed.\n");
-        skLogd(LD_WARN, FT_Error_String(status));
-        return false;
-    }
-
-    if ((status = FT_New_Memory_Face(lib, (const FT_Byte*)mem, (FT_Long)len, 0, &face)) != 0)
+    // the FreeType library is shared by all contexts
+    if ((status = skLibrary::newFace(mem, len, &face)) != 0)
     {
         skLogd(LD_ERROR, "Failed to load font face.\n");
         skLogd(LD_WARN, FT_Error_String(status));
@@ -586,6 +575,7 @@ bool skFont::loadTrueTypeFont(const void* mem, SKsize len, SKuint32 size, SKuint
     {
         skLogd(LD_ERROR, "Failed to set the character size.\n");
         skLogd(LD_WARN, FT_Error_String(status));
+        skLibrary::doneFace(face);
         return false;
     }
 
@@ -598,6 +588,7 @@ bool skFont::loadTrueTypeFont(const void* mem, SKsize len, SKuint32 size, SKuint
     if (!ima)
     {
         skLogd(LD_ERROR, "Failed to create the font image.\n");
+        skLibrary::doneFace(face);
         return false;
     }
 
@@ -641,8 +632,7 @@ bool skFont::loadTrueTypeFont(const void* mem, SKsize len, SKuint32 size, SKuint
         delete glyph;
     }
 
-    FT_Done_Face(face);
-    FT_Done_FreeType(lib);
+    skLibrary::doneFace(face);
     getAverageWidth();
 
     m_glyphs.clear();
@@ -0,0 +1,78 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "ft2build.h"
+#include FT_FREETYPE_H
+
+#include <mutex>
+#include "Image/skImage.h"
+#include "skLibrary.h"
+
+static std::mutex g_libraryLock;
+static SKuint32   g_libraryRefs = 0;
+static FT_Library g_freeType    = nullptr;
+
+void skLibrary::initialize(void)
+{
+    std::lock_guard<std::mutex> lock(g_libraryLock);
+    if (g_libraryRefs++ > 0)
+        return;
+
+    skImage::initialize();
+
+    if (FT_Init_FreeType(&g_freeType) != 0)
+        g_freeType = nullptr;
+}
+
+void skLibrary::finalize(void)
+{
+    std::lock_guard<std::mutex> lock(g_libraryLock);
+    if (g_libraryRefs == 0 || --g_libraryRefs > 0)
+        return;
+
+    if (g_freeType)
+        FT_Done_FreeType(g_freeType);
+    g_freeType = nullptr;
+
+    skImage::finalize();
+}
+
+SKuint32 skLibrary::getReferenceCount(void)
+{
+    std::lock_guard<std::mutex> lock(g_libraryLock);
+    return g_libraryRefs;
+}
+
+SKint32 skLibrary::newFace(const void* mem, SKsize len, FT_FaceRec_** face)
+{
+    std::lock_guard<std::mutex> lock(g_libraryLock);
+    if (!g_freeType)
+        return FT_Err_Invalid_Library_Handle;
+
+    return FT_New_Memory_Face(g_freeType, (const FT_Byte*)mem, (FT_Long)len, 0, face);
+}
+
+void skLibrary::doneFace(FT_FaceRec_* face)
+{
+    std::lock_guard<std::mutex> lock(g_libraryLock);
+    if (face)
+        FT_Done_Face(face);
+}
@@ -0,0 +1,49 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skLibrary_h_
+#define _skLibrary_h_
+
+#include "Utils/Config/skConfig.h"
+
+struct FT_FaceRec_;
+
+// Process wide state shared by every context. Each context holds a
+// reference, the first one sets the libraries up and the last one
+// tears them down.
+class skLibrary
+{
+public:
+    static void initialize(void);
+
+    static void finalize(void);
+
+    static SKuint32 getReferenceCount(void);
+
+    // FreeType's library handle is not safe to use from more than one
+    // thread, so faces are opened and closed under a lock. Loading
+    // glyphs from separate faces needs no lock.
+    static SKint32 newFace(const void* mem, SKsize len, FT_FaceRec_** face);
+
+    static void doneFace(FT_FaceRec_* face);
+};
+
+#endif  //_skLibrary_h_
@@ -34,7 +34,15 @@ skPaint::skPaint()
     m_brushPattern = nullptr;
     m_program      = nullptr;
     m_lineType     = SK_LINE_LOOP;
+    m_fillRule     = SK_NON_ZERO;
+    m_fillMode     = SK_FILL_TESSELLATE;
+    m_penJoin      = SK_JOIN_MITER;
+    m_penCap       = SK_CAP_BUTT;
+    m_dashPhase    = 0;
     m_autoClear    = 0;
+
+    const SKscalar dashes[2] = {SK_DEFAULT_DASH, SK_DEFAULT_DASH};
+    setDashes(dashes, 2);
 }
 
 skPaint::~skPaint() = default;
@@ -63,6 +71,21 @@ void skPaint::getI(SKpaintStyle opt, SKint32* v) const
     case SK_AUTO_CLEAR:
         *v = (SKint32)m_autoClear;
         break;
+    case SK_FILL_RULE:
+        *v = (SKint32)m_fillRule;
+        break;
+    case SK_FILL_MODE:
+        *v = (SKint32)m_fillMode;
+        break;
+    case SK_PEN_JOIN:
+        *v = (SKint32)m_penJoin;
+        break;
+    case SK_PEN_CAP:
+        *v = (SKint32)m_penCap;
+        break;
+    case SK_DASH_PHASE:
+        *v = (SKint32)m_dashPhase;
+        break;
     default:
         break;
     }
@@ -90,6 +113,21 @@ void skPaint::setI(SKpaintStyle opt, SKint32 v)
     case SK_AUTO_CLEAR:
         m_autoClear = (SKint8)v != 0;
         break;
+    case SK_FILL_RULE:
+        m_fillRule = skClamp<SKint32>(v, SK_FR_MIN + 1, SK_FR_MAX - 1);
+        break;
+    case SK_FILL_MODE:
+        m_fillMode = skClamp<SKint32>(v, SK_FM_MIN + 1, SK_FM_MAX - 1);
+        break;
+    case SK_PEN_JOIN:
+        m_penJoin = skClamp<SKint32>(v, SK_PJ_MIN + 1, SK_PJ_MAX - 1);
+        break;
+    case SK_PEN_CAP:
+        m_penCap = skClamp<SKint32>(v, SK_PC_MIN + 1, SK_PC_MAX - 1);
+        break;
+    case SK_DASH_PHASE:
+        m_dashPhase = (SKscalar)v;
+        break;
     default:
         break;
     }
@@ -119,6 +157,21 @@ void skPaint::getF(SKpaintStyle opt, SKscalar* v) const
     case SK_LINE_TYPE:
         *v = (SKscalar)m_lineType;
         break;
+    case SK_FILL_RULE:
+        *v = (SKscalar)m_fillRule;
+        break;
+    case SK_FILL_MODE:
+        *v = (SKscalar)m_fillMode;
+        break;
+    case SK_PEN_JOIN:
+        *v = (SKscalar)m_penJoin;
+        break;
+    case SK_PEN_CAP:
+        *v = (SKscalar)m_penCap;
+        break;
+    case SK_DASH_PHASE:
+        *v = m_dashPhase;
+        break;
     default:
         break;
     }
@@ -146,6 +199,21 @@ void skPaint::setF(SKpaintStyle opt, SKscalar v)
     case SK_AUTO_CLEAR:
         m_autoClear = (SKuint8)((int)v ? 1 : 0);
         break;
+    case SK_FILL_RULE:
+        m_fillRule = skClamp<SKint32>((SKint32)v, SK_FR_MIN + 1, SK_FR_MAX - 1);
+        break;
+    case SK_FILL_MODE:
+        m_fillMode = skClamp<SKint32>((SKint32)v, SK_FM_MIN + 1, SK_FM_MAX - 1);
+        break;
+    case SK_PEN_JOIN:
+        m_penJoin = skClamp<SKint32>((SKint32)v, SK_PJ_MIN + 1, SK_PJ_MAX - 1);
+        break;
+    case SK_PEN_CAP:
+        m_penCap = skClamp<SKint32>((SKint32)v, SK_PC_MIN + 1, SK_PC_MAX - 1);
+        break;
+    case SK_DASH_PHASE:
+        m_dashPhase = v;
+        break;
     default:
         break;
     }
@@ -201,3 +269,21 @@ void skPaint::setT(SKpaintStyle opt, skTexture* v)
     if (opt == SK_BRUSH_PATTERN)
         m_brushPattern = v;
 }
+
+void skPaint::setDashes(const SKscalar* pattern, SKuint32 count)
+{
+    m_dashes.resizeFast(0);
+    if (!pattern || count == 0)
+        return;
+
+    skScalar period = 0;
+    for (SKuint32 i = 0; i < count; ++i)
+        period += skMax<SKscalar>(pattern[i], 0);
+    if (period <= 0)
+        return;
+
+    const SKuint32 nr = count % 2 ? count * 2 : count;
+    m_dashes.reserve(nr);
+    for (SKuint32 i = 0; i < nr; ++i)
+        m_dashes.push_back(skMax<SKscalar>(pattern[i % count], 0));
+}
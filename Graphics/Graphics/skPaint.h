@@ -26,6 +26,8 @@
 
 class skCachedProgram;
 
+// the on and off length of the default dash pattern
+#define SK_DEFAULT_DASH 4
 
 
 
@@ -33,18 +35,25 @@ class skPaint : public skContextObj
 {
 private:
     friend class skOpenGLRenderer;
-
-    SKbrushStyle     m_brushStyle;
-    SKbrushMode      m_brushMode;
-    SKpenStyle       m_penStyle;
-    SKscalar         m_penWidth;
-    skColor          m_brushColor;
-    skColor          m_penColor;
-    skColor          m_surfaceColor;
-    skTexture*       m_brushPattern;
-    SKint32          m_lineType;
-    SKint8           m_autoClear;
-    skCachedProgram* m_program;
+    friend class skSoftwareRenderer;
+
+    SKbrushStyle      m_brushStyle;
+    SKbrushMode       m_brushMode;
+    SKpenStyle        m_penStyle;
+    SKscalar          m_penWidth;
+    skColor           m_brushColor;
+    skColor           m_penColor;
+    skColor           m_surfaceColor;
+    skTexture*        m_brushPattern;
+    SKint32           m_lineType;
+    SKfillRule        m_fillRule;
+    SKfillMode        m_fillMode;
+    SKpenJoin         m_penJoin;
+    SKpenCap          m_penCap;
+    skArray<skScalar> m_dashes;
+    SKscalar          m_dashPhase;
+    SKint8            m_autoClear;
+    skCachedProgram*  m_program;
 
 public:
     skPaint();
@@ -70,6 +79,15 @@ public:
     void getT(SKpaintStyle opt, skTexture** v) const;
 
     void setT(SKpaintStyle opt, skTexture* v);
+
+    // An odd pattern is repeated to make it even. An empty
+    // one, or one without any length, strokes solid lines.
+    void setDashes(const SKscalar* pattern, SKuint32 count);
+
+    const skArray<skScalar>& getDashes(void) const
+    {
+        return m_dashes;
+    }
 };
 
 #endif  //_skPaint_h_
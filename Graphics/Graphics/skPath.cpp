@@ -21,6 +21,8 @@
 */
 #include "skPath.h"
 #include "skContext.h"
+#include "skStroker.h"
+#include "skTessellator.h"
 #include "skVertexBuffer.h"
 
 #define vTOL 0.01f
@@ -35,13 +37,49 @@ skPath::skPath()
     m_bias.x     = 0.f;
     m_bias.y     = 0.f;
     m_buffer     = nullptr;
+    m_bufferUV   = false;
+
+    m_drawGeneration = SK_NPOS32;
+    m_drawCount      = 0;
+    m_fill           = nullptr;
+    m_fillGeneration = SK_NPOS32;
+    m_fillRule       = SK_FR_MIN;
+    m_convex         = false;
+
+    m_stroke           = nullptr;
+    m_strokeGeneration = SK_NPOS32;
+    m_strokeWidth      = 0;
+    m_strokeJoin       = SK_PJ_MIN;
+    m_strokeCap        = SK_PC_MIN;
+    m_strokeList       = false;
+
+    m_lengthGeneration = SK_NPOS32;
+    m_lengthList       = false;
+    m_dash             = nullptr;
+    m_dashGeneration   = SK_NPOS32;
+    m_dashPhase        = 0;
+    m_dashList         = false;
+
+    m_simplifyMode      = SK_SIMPLIFY_NONE;
+    m_simplifyTolerance = 0;
+    m_simple            = nullptr;
+    m_simpleGeneration  = SK_NPOS32;
+    m_simpleScale       = 0;
 }
 
 skPath::~skPath()
 {
     delete m_buffer;
+    delete m_fill;
+    delete m_stroke;
+    delete m_dash;
+    delete m_simple;
 
     m_buffer = nullptr;
+    m_fill   = nullptr;
+    m_stroke = nullptr;
+    m_dash   = nullptr;
+    m_simple = nullptr;
     delete m_contour;
     m_contour = nullptr;
 }
@@ -58,6 +96,13 @@ void skPath::setBias(skScalar x, skScalar y)
     m_bias.y = y;
 }
 
+void skPath::setSimplify(SKsimplifyMode mode, skScalar tolerance)
+{
+    m_simplifyMode      = skClamp<SKint32>(mode, SK_SM_MIN + 1, SK_SM_MAX - 1);
+    m_simplifyTolerance = skMax<skScalar>(tolerance, 0);
+    m_simpleGeneration  = SK_NPOS32;
+}
+
 void skPath::arcTo(skScalar  x,
                    skScalar  y,
                    skScalar  w,
@@ -69,15 +114,13 @@ void skPath::arcTo(skScalar  x,
     if (!m_ctx)
         return;
 
-    SKint32 vertexCount = m_ctx->getVerticesPerSegment();
-    if (vertexCount <= 0)
-        vertexCount = 8;
-
-    const skScalar step = skRadians(skDegrees(angle2) / (skScalar)vertexCount);
-
     skScalar       s, c;
     const skScalar hw = w * 0.5f;
     const skScalar hh = h * 0.5f;
+
+    const SKint32  vertexCount = getArcSegments(skMax(hw, hh), angle2);
+    const skScalar step        = skRadians(skDegrees(angle2) / (skScalar)vertexCount);
+
     const skScalar cx = x + hw;
     const skScalar cy = y + hw;
 
@@ -98,39 +141,94 @@ void skPath::arcTo(skScalar  x,
 
 void skPath::cubicTo(skScalar fx, skScalar fy, skScalar tx, skScalar ty)
 {
-    SKint32 vertexCount = m_ctx->getVerticesPerSegment();
-    if (vertexCount <= 0)
-        vertexCount = 8;
+    // an s shaped curve that leaves and enters horizontally
+    const skScalar hd = skVector2(fx, fy).distance(skVector2(tx, ty)) * .5f;
+
+    moveFrom(fx, fy);
+    bezierTo(fx + hd, fy, tx - hd, ty, tx, ty);
+}
+
+void skPath::quadTo(skScalar cx, skScalar cy, skScalar x, skScalar y)
+{
+    if (!m_ctx)
+        return;
+
+    if (m_contour->empty())
+        moveTo(m_cur.x, m_cur.y);
 
-    const skScalar step = skScalar(1.0) / skScalar(vertexCount);
-    const skScalar hd   = skVector2(fx, fy).distance(skVector2(tx, ty)) * .5f;
+    const skVector2 points[3] = {
+        skVector2(m_cur.x, m_cur.y),
+        skVector2(cx, cy),
+        skVector2(x, y),
+    };
 
-    skScalar s = 1.f, t = 0.f;
+    const SKint32  vertexCount = getCurveSegments(points, 2);
+    const skScalar h           = skScalar(1.0) / skScalar(vertexCount);
 
-    const skVector2 c0 = skVector2(fx, fy);
-    const skVector2 c1 = skVector2(c0.x + hd, c0.y);
-    const skVector2 c3 = skVector2(tx, ty);
-    const skVector2 c2 = skVector2(c3.x - hd, c3.y);
+    // Forward differences of p(t) = at^2 + bt + p0, each
+    // step is then two additions rather than a polynomial.
+    const skVector2 a = points[0] - points[1] * skScalar(2) + points[2];
+    const skVector2 b = (points[1] - points[0]) * skScalar(2);
 
-    moveTo(c0.x, c0.y);
+    skVector2 p  = points[0];
+    skVector2 d1 = a * (h * h) + b * h;
+    skVector2 d2 = a * (skScalar(2) * h * h);
 
-    while (t <= skScalar(1.0))
+    for (SKint32 i = 1; i < vertexCount; ++i)
     {
-        const skScalar sss  = s * s * s;
-        const skScalar ttt  = t * t * t;
-        const skScalar sst3 = skScalar(3.0) * s * s * t;
-        const skScalar tts3 = skScalar(3.0) * t * t * s;
+        p += d1;
+        d1 += d2;
+        lineTo(p.x, p.y);
+    }
+
+    // the end point is exact
+    lineTo(x, y);
+}
 
-        const skVector2 cr = skVector2(
-            sss * c0.x + sst3 * c1.x + tts3 * c2.x + ttt * c3.x,
-            sss * c0.y + sst3 * c1.y + tts3 * c2.y + ttt * c3.y);
+void skPath::bezierTo(skScalar c1x,
+                      skScalar c1y,
+                      skScalar c2x,
+                      skScalar c2y,
+                      skScalar x,
+                      skScalar y)
+{
+    if (!m_ctx)
+        return;
 
-        lineTo(cr.x, cr.y);
-        t += step;
-        s = skScalar(1.0) - t;
+    if (m_contour->empty())
+        moveTo(m_cur.x, m_cur.y);
+
+    const skVector2 points[4] = {
+        skVector2(m_cur.x, m_cur.y),
+        skVector2(c1x, c1y),
+        skVector2(c2x, c2y),
+        skVector2(x, y),
+    };
+
+    const SKint32  vertexCount = getCurveSegments(points, 3);
+    const skScalar h           = skScalar(1.0) / skScalar(vertexCount);
+    const skScalar hh          = h * h;
+    const skScalar hhh         = hh * h;
+
+    // p(t) = at^3 + bt^2 + ct + p0
+    const skVector2 a = (points[1] - points[2]) * skScalar(3) + points[3] - points[0];
+    const skVector2 b = (points[0] - points[1] * skScalar(2) + points[2]) * skScalar(3);
+    const skVector2 c = (points[1] - points[0]) * skScalar(3);
+
+    skVector2 p  = points[0];
+    skVector2 d1 = a * hhh + b * hh + c * h;
+    skVector2 d2 = a * (skScalar(6) * hhh) + b * (skScalar(2) * hh);
+    skVector2 d3 = a * (skScalar(6) * hhh);
+
+    for (SKint32 i = 1; i < vertexCount; ++i)
+    {
+        p += d1;
+        d1 += d2;
+        d2 += d3;
+        lineTo(p.x, p.y);
     }
 
-    lineTo(c3.x, c3.y);
+    lineTo(x, y);
 }
 
 void skPath::rectTo(skScalar fx, skScalar fy, skScalar tx, skScalar ty)
@@ -142,7 +240,7 @@ void skPath::rectTo(skScalar fx, skScalar fy, skScalar tx, skScalar ty)
     if (tx - fac < cv)
         cv = tx - fac;
 
-    moveTo(fx, fy);
+    moveFrom(fx, fy);
     lineTo(cv, fy);
     lineTo(cv, ty);
     lineTo(tx, ty);
@@ -155,15 +253,86 @@ void skPath::moveTo(skScalar x, skScalar y)
     m_mov.x = x;
     m_mov.y = y;
 
+    // a move on a path that is not empty starts a new subpath
     m_contour->reserve(m_reserve);
+    m_contour->startSubpath();
     pushVertex(m_cur);
 }
 
+void skPath::moveFrom(skScalar x, skScalar y)
+{
+    // carries on from the current point rather than starting over
+    if (m_contour->empty() || !skEqT(x, m_cur.x, vTOL) || !skEqT(y, m_cur.y, vTOL))
+        moveTo(x, y);
+}
+
 void skPath::lineTo(skScalar x, skScalar y)
 {
     pushLine(x, y);
 }
 
+void skPath::appendVertices(const skScalar* xy, SKuint32 count, SKuint32 flags)
+{
+    if (!m_ctx || !xy || count == 0)
+        return;
+
+    // the same mapping pushVertex applies to each vertex
+    skScalar sx = m_scale.x, sy = m_scale.y;
+    skScalar bx = m_bias.x, by = m_bias.y;
+
+    if (m_ctx->getContextI(SK_METRICS_MODE) == SK_RELATIVE)
+    {
+        const skVector2 size = m_ctx->getSize();
+        sx *= size.x;
+        sy *= size.y;
+        bx *= size.x;
+        by *= size.y;
+    }
+
+    if (flags & SK_APPEND_MOVE || m_contour->empty())
+    {
+        m_contour->startSubpath();
+        m_mov.x = xy[0];
+        m_mov.y = xy[1];
+    }
+
+    skPoly&        vertices = m_contour->vertices;
+    const SKuint32 base     = vertices.size();
+    vertices.resize(base + count);
+
+    skVertex* dst = vertices.ptr() + base;
+
+    skScalar x1 = xy[0] * sx + bx, x2 = x1;
+    skScalar y1 = xy[1] * sy + by, y2 = y1;
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        const skScalar x = xy[i * 2] * sx + bx;
+        const skScalar y = xy[i * 2 + 1] * sy + by;
+
+        dst[i].x = x;
+        dst[i].y = y;
+        dst[i].u = 0;
+        dst[i].v = 0;
+
+        x1 = skMin(x1, x);
+        y1 = skMin(y1, y);
+        x2 = skMax(x2, x);
+        y2 = skMax(y2, y);
+    }
+
+    m_bounds.compare(x1, y1);
+    m_bounds.compare(x2, y2);
+
+    m_cur.x = xy[count * 2 - 2];
+    m_cur.y = xy[count * 2 - 1];
+
+    m_contour->touch();
+    m_texCoBuilt = false;
+
+    if (flags & SK_APPEND_CLOSE)
+        close();
+}
+
 void skPath::close(void)
 {
     pushVertex(m_mov);
@@ -176,6 +345,148 @@ void skPath::clear(void)
     m_contour->clear();
 }
 
+void skPath::copy(const skPath& src)
+{
+    m_cur        = src.m_cur;
+    m_mov        = src.m_mov;
+    m_bounds     = src.m_bounds;
+    m_scale      = src.m_scale;
+    m_bias       = src.m_bias;
+    m_texCoBuilt = src.m_texCoBuilt;
+    *m_contour   = *src.m_contour;
+
+    m_simplifyMode      = src.m_simplifyMode;
+    m_simplifyTolerance = src.m_simplifyTolerance;
+}
+
+void skPath::transform(const skScalar* m)
+{
+    m_bounds.clear();
+
+    skPoly& vertices = m_contour->vertices;
+    for (SKuint32 i = 0; i < vertices.size(); ++i)
+    {
+        skVertex&      v = vertices[i];
+        const skScalar x = v.x;
+
+        v.x = m[0] * x + m[1] * v.y + m[2];
+        v.y = m[3] * x + m[4] * v.y + m[5];
+        m_bounds.compare(v.x, v.y);
+    }
+
+    skScalar x = m_cur.x;
+    m_cur.x    = m[0] * x + m[1] * m_cur.y + m[2];
+    m_cur.y    = m[3] * x + m[4] * m_cur.y + m[5];
+
+    x       = m_mov.x;
+    m_mov.x = m[0] * x + m[1] * m_mov.y + m[2];
+    m_mov.y = m[3] * x + m[4] * m_mov.y + m[5];
+
+    m_contour->touch();
+}
+
+void skPath::makeStatic(bool texCoords)
+{
+    // upload the vertices once, any later change
+    // goes back to streaming them on every draw
+    if ((isStatic() && (m_bufferUV || !texCoords)) || m_contour->empty())
+        return;
+
+    validateBuffer(texCoords);
+    if (m_buffer)
+    {
+        m_buffer->writeVertices(
+            m_contour->vertices.ptr(),
+            m_contour->vertices.size(),
+            SK_STATIC_DRAW);
+
+        // an empty list goes back to drawing the vertices in order
+        m_buffer->writeIndices(
+            m_contour->indices.ptr(),
+            m_contour->indices.size(),
+            SK_STATIC_DRAW);
+        m_buffer->setGeneration(m_contour->generation);
+    }
+}
+
+bool skPath::isStatic(void) const
+{
+    return m_buffer && m_buffer->getGeneration() == m_contour->generation;
+}
+
+skVertexBuffer* skPath::getDrawBuffer(bool texCoords)
+{
+    // a buffer with coordinates serves both layouts
+    if (isStatic() && (m_bufferUV || !texCoords))
+        return m_buffer;
+
+    if (m_drawGeneration != m_contour->generation)
+    {
+        m_drawGeneration = m_contour->generation;
+        m_drawCount      = 0;
+    }
+
+    if (++m_drawCount >= SK_STATIC_PROMOTE_DRAWS)
+        makeStatic(texCoords);
+
+    if (isStatic() && (m_bufferUV || !texCoords))
+        return m_buffer;
+    return nullptr;
+}
+
+bool skPath::isConvex(void)
+{
+    // a new outline also needs new triangles
+    if (m_fillGeneration != m_contour->generation)
+    {
+        m_fillGeneration = m_contour->generation;
+        m_fillRule       = SK_FR_MIN;
+        m_convex         = m_contour->subpathCount() < 2 &&
+                   skTessellator::isConvex(m_contour->vertices.ptr(),
+                                           m_contour->vertices.size());
+    }
+    return m_convex;
+}
+
+skPath* skPath::getFillPath(SKfillRule rule)
+{
+    // triangle lists already fill as they are
+    if (m_contour->indexed() || m_contour->vertices.size() < 4)
+        return this;
+
+    // the triangles carry the coordinates along, so they
+    // are built first rather than after tessellating
+    makeUV();
+
+    if (isConvex())
+        return this;
+
+    if (!m_fill)
+    {
+        m_fill = new skPath();
+        m_fill->setContext(m_ctx);
+    }
+
+    if (m_fillRule != rule)
+    {
+        m_fillRule = rule;
+
+        // every subpath adds its edges to the one winding
+        skTessellator tess;
+        for (SKuint32 i = 0; i < m_contour->subpathCount(); ++i)
+        {
+            SKuint32 first, count;
+            m_contour->getSubpath(i, first, count);
+            tess.addContour(m_contour->vertices.ptr() + first, count);
+        }
+        tess.tessellate(rule, *m_fill->m_contour);
+
+        m_fill->m_bounds     = m_bounds;
+        m_fill->m_texCoBuilt = true;
+    }
+    return m_fill;
+}
+
 void skPath::makeRect(skScalar x, skScalar y, skScalar w, skScalar h)
 {
     if (!m_ctx)
@@ -196,17 +507,17 @@ void skPath::makeEllipse(skScalar x, skScalar y, skScalar w, skScalar h)
         return;
 
     clear();
-    SKint32 vertexCount = m_ctx->getVerticesPerSegment();
-    if (vertexCount <= 0)
-        vertexCount = 8;
-
-    const skScalar iStep = skPi2 / skScalar(vertexCount);
 
     const skScalar hw = w * 0.5f;
     const skScalar hh = h * 0.5f;
     const skScalar cx = x + hw;
     const skScalar cy = y + hh;
 
+    const SKint32 vertexCount = skMax<SKint32>(getArcSegments(skMax(hw, hh), skPi2),
+                                               SK_MIN_VERTICES_PER_SEGMENT);
+
+    const skScalar iStep = skPi2 / skScalar(vertexCount);
+
     m_reserve = vertexCount;
 
     skScalar s, c;
@@ -228,9 +539,6 @@ void skPath::rectCurveTo(skScalar x,
                          skScalar angle1,
                          skScalar angle2)
 {
-    const SKint32  vertexCount = m_ctx->getVerticesPerSegment();
-    const skScalar step        = skRadians(skDegrees(angle2) / (skScalar)vertexCount);
-
     const skVector2 v0(m_cur.x, m_cur.y);
     const skVector2 v1(x, y);
     const skVector2 cv = (v1 + v0) / 2.f;
@@ -238,6 +546,9 @@ void skPath::rectCurveTo(skScalar x,
     const skScalar hw = w * 0.5f;
     const skScalar hh = h * 0.5f;
 
+    const SKint32  vertexCount = getArcSegments(skMax(hw, hh), angle2);
+    const skScalar step        = skRadians(skDegrees(angle2) / (skScalar)vertexCount);
+
     skScalar s, c;
     skScalar a = angle1;
 
@@ -318,7 +629,8 @@ void skPath::makeRoundRect(skScalar x,
 void skPath::makeStar(SKscalar x, SKscalar y, SKscalar w, SKscalar h, SKint32 Q, SKint32 P)
 {
     clear();
-    // there is no tessellation so this will not work for fills
+    // self intersecting when P > 1, so the inner
+    // part is left open with SK_EVEN_ODD fills
     // https://www.desmos.com/calculator/3jyqtcbssp
 
     Q = skMax(2, Q);
@@ -405,19 +717,493 @@ void skPath::pushVertex(const skVertex& v)
             pv.y *= size.y;
         }
 
-        if (!m_buffer)
+        m_bounds.compare(pv.x, pv.y);
+        m_contour->push_back(pv);
+        m_texCoBuilt = false;
+    }
+}
+
+void skPath::validateBuffer(bool texCoords)
+{
+    if (m_buffer && m_bufferUV != texCoords)
+    {
+        delete m_buffer;
+        m_buffer = nullptr;
+    }
+
+    if (!m_buffer && m_ctx)
+    {
+        m_buffer   = m_ctx->createBuffer();
+        m_bufferUV = texCoords;
+        if (m_buffer)
         {
-            m_buffer = m_ctx->createBuffer();
-            if (m_buffer)
-            {
-                m_buffer->addElement(SK_ATTR_POSITION, SK_FLOAT2_32);
+            m_buffer->addElement(SK_ATTR_POSITION, SK_FLOAT2_32);
+            if (texCoords)
                 m_buffer->addElement(SK_ATTR_TEXTURE0, SK_FLOAT2_32);
+        }
+    }
+}
+
+skScalar skPath::getDeviceScale(bool pathUnits) const
+{
+    // the lengths of the transformed x and y axes
+    const skScalar* m = m_ctx->getMatrix().p;
+
+    skScalar sx = skSqrt(m[0] * m[0] + m[4] * m[4]);
+    skScalar sy = skSqrt(m[1] * m[1] + m[5] * m[5]);
+    if (!pathUnits)
+        return skMax(sx, sy);
+
+    sx *= skAbs(m_scale.x);
+    sy *= skAbs(m_scale.y);
+
+    if (m_ctx->getContextI(SK_METRICS_MODE) == SK_RELATIVE)
+    {
+        const skVector2 size = m_ctx->getSize();
+        sx *= size.x;
+        sy *= size.y;
+    }
+    return skMax(sx, sy);
+}
+
+SKint32 skPath::getArcSegments(skScalar radius, skScalar angle, bool pathUnits) const
+{
+    const skScalar tolerance = m_ctx->getFlattenTolerance();
+    if (tolerance <= 0)
+    {
+        const SKint32 vertexCount = m_ctx->getVerticesPerSegment();
+        return vertexCount > 0 ? vertexCount : 8;
+    }
+
+    // A chord across the angle a strays r(1 - cos(a / 2)) from
+    // the arc, which is close to r a^2 / 8 for small angles.
+    const skScalar r = radius * getDeviceScale(pathUnits);
+    if (r <= tolerance)
+        return 1;
+
+    const skScalar n = skAbs(angle) * skSqrt(r / (tolerance * 8));
+
+    SKint32 vertexCount = SKint32(n);
+    if (skScalar(vertexCount) < n)
+        ++vertexCount;
+    return skClamp<SKint32>(vertexCount, 1, SK_MAX_VERTICES_PER_SEGMENT);
+}
+
+SKint32 skPath::getCurveSegments(const skVector2* points, SKint32 degree) const
+{
+    const skScalar tolerance = m_ctx->getFlattenTolerance();
+    if (tolerance <= 0 || degree < 2)
+    {
+        const SKint32 vertexCount = m_ctx->getVerticesPerSegment();
+        return vertexCount > 0 ? vertexCount : 8;
+    }
+
+    // Wang's formula, the flat segments stay within the tolerance
+    // when n >= sqrt(d(d - 1) / 8 * max|p[i] - 2p[i+1] + p[i+2]| / tol)
+    skScalar dd = 0;
+    for (SKint32 i = 0; i + 2 <= degree; ++i)
+    {
+        const skVector2 d = points[i] - points[i + 1] * skScalar(2) + points[i + 2];
+        dd                = skMax(dd, d.length());
+    }
+
+    const skScalar k = skScalar(degree * (degree - 1)) / skScalar(8);
+    const skScalar n = skSqrt(k * dd * getDeviceScale() / tolerance);
+
+    SKint32 vertexCount = SKint32(n);
+    if (skScalar(vertexCount) < n)
+        ++vertexCount;
+    return skClamp<SKint32>(vertexCount, 1, SK_MAX_VERTICES_PER_SEGMENT);
+}
+
+skPath* skPath::getStrokePath(skScalar width, SKpenJoin join, SKpenCap cap, bool list)
+{
+    if (!m_stroke)
+    {
+        m_stroke = new skPath();
+        m_stroke->setContext(m_ctx);
+    }
+
+    if (m_strokeGeneration == m_contour->generation &&
+        m_strokeWidth == width &&
+        m_strokeJoin == join &&
+        m_strokeCap == cap &&
+        m_strokeList == list)
+        return m_stroke;
+
+    m_strokeGeneration = m_contour->generation;
+    m_strokeWidth      = width;
+    m_strokeJoin       = join;
+    m_strokeCap        = cap;
+    m_strokeList       = list;
+
+    // the pen width is measured on the stored vertices
+    skStroker stroker(width, join, cap, getArcSegments(width * skScalar(0.5), skPi, false));
+
+    skContour&    out      = *m_stroke->m_contour;
+    const skPoly& vertices = m_contour->vertices;
+
+    out.clear();
+    if (list)
+    {
+        const SKuint32 nr = vertices.size();
+        for (SKuint32 i = 0; i + 1 < nr;)
+        {
+            // pairs that carry on from where the last one ended,
+            // like the pieces of one dash, are joined as one line
+            SKuint32 end = i + 2;
+            while (end + 1 < nr &&
+                   vertices[end - 1].x == vertices[end].x &&
+                   vertices[end - 1].y == vertices[end].y)
+                end += 2;
+
+            stroker.stroke(vertices.ptr() + i, end - i, out);
+            i = end;
+        }
+    }
+    else
+    {
+        for (SKuint32 i = 0; i < m_contour->subpathCount(); ++i)
+        {
+            SKuint32 first, count;
+            m_contour->getSubpath(i, first, count);
+            stroker.stroke(vertices.ptr() + first, count, out);
+        }
+    }
+
+    m_stroke->m_bounds.clear();
+    for (SKuint32 i = 0; i < out.vertices.size(); ++i)
+        m_stroke->m_bounds.compare(out.vertices[i].x, out.vertices[i].y);
+
+    m_stroke->m_texCoBuilt = false;
+    return m_stroke;
+}
+
+void skPath::measure(bool list)
+{
+    if (m_lengthGeneration == m_contour->generation && m_lengthList == list)
+        return;
+
+    m_lengthGeneration = m_contour->generation;
+    m_lengthList       = list;
+
+    const skPoly&  vertices = m_contour->vertices;
+    const SKuint32 nr       = vertices.size();
+
+    m_lengths.resizeFast(nr);
+
+    const skIndices& starts = m_contour->starts;
+
+    skScalar total = 0;
+    SKuint32 next  = 0;
+    for (SKuint32 i = 0; i < nr; ++i)
+    {
+        // subpaths start again from nothing
+        bool start = i == 0 || (list && i % 2 == 0);
+        if (!list && next < starts.size() && starts[next] == i)
+        {
+            start = true;
+            ++next;
+        }
+
+        if (!start)
+        {
+            const skScalar dx = vertices[i].x - vertices[i - 1].x;
+            const skScalar dy = vertices[i].y - vertices[i - 1].y;
+            total += skSqrt(dx * dx + dy * dy);
+        }
+        else
+            total = 0;
+
+        m_lengths[i] = total;
+    }
+}
+
+void skPath::addDash(skScalar from, skScalar to, SKuint32 last, SKuint32& cur)
+{
+    const skPoly& vertices = m_contour->vertices;
+    skContour&    out      = *m_dash->m_contour;
+
+    // the dashes only move forward, so the segment is found
+    // by carrying on from the last one
+    while (cur + 1 < last && m_lengths[cur + 1] <= from)
+        ++cur;
+
+    SKuint32 seg = cur;
+    for (;;)
+    {
+        const skVertex& a = vertices[seg];
+        const skVertex& b = vertices[seg + 1];
+
+        const skScalar l0  = m_lengths[seg];
+        const skScalar len = m_lengths[seg + 1] - l0;
+
+        const skScalar t0 = len > 0 ? (skMax(from, l0) - l0) / len : 0;
+        const skScalar t1 = len > 0 ? (skMin(to, l0 + len) - l0) / len : 1;
+
+        out.push_back(skVertex(a.x + (b.x - a.x) * t0, a.y + (b.y - a.y) * t0));
+        out.push_back(skVertex(a.x + (b.x - a.x) * t1, a.y + (b.y - a.y) * t1));
+
+        if (seg + 1 >= last || m_lengths[seg + 1] >= to)
+            break;
+        ++seg;
+    }
+}
+
+skPath* skPath::getDashPath(const skArray<skScalar>& pattern, skScalar phase, bool list)
+{
+    if (!m_dash)
+    {
+        m_dash = new skPath();
+        m_dash->setContext(m_ctx);
+    }
+
+    measure(list);
+
+    // the lengths keep their generation when only the mode changes
+    bool same = m_dashGeneration == m_lengthGeneration &&
+                m_dashList == list &&
+                m_dashPhase == phase &&
+                m_dashPattern.size() == pattern.size();
+    for (SKuint32 i = 0; same && i < pattern.size(); ++i)
+        same = m_dashPattern[i] == pattern[i];
+    if (same)
+        return m_dash;
+
+    m_dashGeneration = m_lengthGeneration;
+    m_dashList       = list;
+    m_dashPhase      = phase;
+    m_dashPattern    = pattern;
+
+    skContour& out = *m_dash->m_contour;
+    out.clear();
+    m_dash->m_bounds.clear();
+    m_dash->m_texCoBuilt = false;
+
+    const SKuint32 nr = m_lengths.size();
+
+    skScalar period = 0;
+    for (SKuint32 i = 0; i < pattern.size(); ++i)
+        period += pattern[i];
+    if (nr < 2 || period <= 0)
+        return m_dash;
+
+    // where the phase puts the start of the outline in the pattern
+    skScalar offset = phase - period * skScalar(SKint32(phase / period));
+    if (offset < 0)
+        offset += period;
+
+    SKuint32 start   = 0;
+    SKuint32 subpath = 0;
+    while (start + 1 < nr)
+    {
+        // each run, a subpath or one pair of a list,
+        // starts the pattern again
+        SKuint32 last = start + 1;
+        if (!list)
+        {
+            SKuint32 first, count;
+            m_contour->getSubpath(subpath++, first, count);
+            last = first + count - 1;
+        }
+
+        const skScalar total = m_lengths[last];
+        if (last <= start || total <= 0)
+        {
+            start = last + 1;
+            continue;
+        }
+
+        SKuint32 k   = 0;
+        SKuint32 cur = start;
+        skScalar pos = -offset;
+        while (pos < total)
+        {
+            const skScalar end = pos + pattern[k];
+            if (k % 2 == 0 && end > 0 && pattern[k] > 0)
+                addDash(skMax<skScalar>(pos, 0), skMin(end, total), last, cur);
+
+            pos = end;
+            k   = (k + 1) % pattern.size();
+        }
+        start = last + 1;
+    }
+
+    for (SKuint32 i = 0; i < out.vertices.size(); ++i)
+        m_dash->m_bounds.compare(out.vertices[i].x, out.vertices[i].y);
+
+    return m_dash;
+}
+
+skPath* skPath::getSimplePath(void)
+{
+    if (m_simplifyMode == SK_SIMPLIFY_NONE ||
+        m_contour->indexed() ||
+        m_contour->vertices.size() < 3)
+        return this;
+
+    if (m_simplifyMode == SK_SIMPLIFY_RDP && m_simplifyTolerance <= 0)
+        return this;
+
+    const skScalar scale = getDeviceScale(false);
+    if (scale <= 0)
+        return this;
+
+    if (!m_simple)
+    {
+        m_simple = new skPath();
+        m_simple->setContext(m_ctx);
+    }
+
+    // one reduction for each change and zoom level
+    if (m_simpleGeneration == m_contour->generation && m_simpleScale == scale)
+        return m_simple;
+
+    m_simpleGeneration = m_contour->generation;
+    m_simpleScale      = scale;
+
+    m_simple->m_contour->clear();
+    m_simple->m_bounds     = m_bounds;
+    m_simple->m_texCoBuilt = false;
+
+    // from pixels back to the units of the stored vertices
+    skScalar tolerance = m_simplifyTolerance;
+    if (m_simplifyMode == SK_SIMPLIFY_MIN_MAX && tolerance <= 0)
+        tolerance = 1;
+    tolerance /= scale;
+
+    for (SKuint32 i = 0; i < m_contour->subpathCount(); ++i)
+    {
+        SKuint32 first, count;
+        m_contour->getSubpath(i, first, count);
+
+        m_simple->m_contour->startSubpath();
+        if (m_simplifyMode == SK_SIMPLIFY_RDP)
+            simplifyRDP(first, count, tolerance);
+        else
+            simplifyMinMax(first, count, tolerance);
+    }
+    return m_simple;
+}
+
+void skPath::simplifyRDP(SKuint32 first, SKuint32 count, skScalar tolerance)
+{
+    const skVertex* src = m_contour->vertices.ptr() + first;
+    skContour&      out = *m_simple->m_contour;
+
+    if (count < 3)
+    {
+        for (SKuint32 i = 0; i < count; ++i)
+            out.push_back(src[i]);
+        return;
+    }
+
+    skArray<SKuint8> keep;
+    keep.resize(count);
+    for (SKuint32 i = 0; i < count; ++i)
+        keep[i] = 0;
+    keep[0]         = 1;
+    keep[count - 1] = 1;
+
+    const skScalar tol2 = tolerance * tolerance;
+
+    // Ramer-Douglas-Peucker, with the spans still to be split
+    // on a stack rather than in recursion
+    skIndices spans;
+    spans.push_back(0);
+    spans.push_back(count - 1);
+
+    while (!spans.empty())
+    {
+        const SKuint32 a = spans[spans.size() - 2];
+        const SKuint32 b = spans[spans.size() - 1];
+        spans.resizeFast(spans.size() - 2);
+
+        const skScalar dx   = src[b].x - src[a].x;
+        const skScalar dy   = src[b].y - src[a].y;
+        const skScalar len2 = dx * dx + dy * dy;
+
+        SKuint32 far  = a;
+        skScalar far2 = tol2;
+        for (SKuint32 i = a + 1; i < b; ++i)
+        {
+            const skScalar px = src[i].x - src[a].x;
+            const skScalar py = src[i].y - src[a].y;
+
+            skScalar t = len2 > 0 ? (px * dx + py * dy) / len2 : 0;
+            t          = skClamp<skScalar>(t, 0, 1);
+
+            const skScalar ex = px - dx * t;
+            const skScalar ey = py - dy * t;
+            const skScalar d2 = ex * ex + ey * ey;
+            if (d2 > far2)
+            {
+                far  = i;
+                far2 = d2;
             }
         }
 
-        m_bounds.compare(pv.x, pv.y);
-        m_contour->push_back(pv);
-        m_texCoBuilt = false;
+        if (far != a)
+        {
+            keep[far] = 1;
+            spans.push_back(a);
+            spans.push_back(far);
+            spans.push_back(far);
+            spans.push_back(b);
+        }
+    }
+
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        if (keep[i])
+            out.push_back(src[i]);
+    }
+}
+
+static SKint32 skPathColumn(skScalar x, skScalar width)
+{
+    const skScalar c   = x / width;
+    SKint32        col = SKint32(c);
+    if (skScalar(col) > c)
+        --col;
+    return col;
+}
+
+void skPath::simplifyMinMax(SKuint32 first, SKuint32 count, skScalar width)
+{
+    const skVertex* src = m_contour->vertices.ptr() + first;
+    skContour&      out = *m_simple->m_contour;
+
+    SKuint32 i = 0;
+    while (i < count)
+    {
+        // the run of points that land in the same column
+        const SKint32 column = skPathColumn(src[i].x, width);
+
+        SKuint32 end = i + 1, lo = i, hi = i;
+        while (end < count && skPathColumn(src[end].x, width) == column)
+        {
+            if (src[end].y < src[lo].y)
+                lo = end;
+            if (src[end].y > src[hi].y)
+                hi = end;
+            ++end;
+        }
+
+        // kept in the order they were added
+        const SKuint32 last = end - 1;
+        const SKuint32 a    = skMin(lo, hi);
+        const SKuint32 b    = skMax(lo, hi);
+
+        out.push_back(src[i]);
+        if (a != i)
+            out.push_back(src[a]);
+        if (b != a && b != i)
+            out.push_back(src[b]);
+        if (last != b && last != i)
+            out.push_back(src[last]);
+
+        i = end;
     }
 }
 
@@ -427,6 +1213,27 @@ void skPath::addVertex(const skVertex& v)
     m_texCoBuilt = true;
 }
 
+void skPath::addQuad(const skVertex& a, const skVertex& b, const skVertex& c, const skVertex& d)
+{
+    const SKuint32 base = m_contour->vertices.size();
+
+    addVertex(a);
+    addVertex(b);
+    addVertex(c);
+    addVertex(d);
+
+    if (m_contour->vertices.size() != base + 4)
+        return;
+
+    skIndices& indices = m_contour->indices;
+    indices.push_back(base);
+    indices.push_back(base + 1);
+    indices.push_back(base + 2);
+    indices.push_back(base + 2);
+    indices.push_back(base + 3);
+    indices.push_back(base);
+}
+
 void skPath::pushLine(skScalar x, skScalar y)
 {
     if (skEqT(x, m_cur.x, vTOL) && skEqT(y, m_cur.y, vTOL))
@@ -448,6 +1255,7 @@ void skPath::makeUV(skScalar x, skScalar y, skScalar w, skScalar h)
         return;
 
     m_texCoBuilt = true;
+    m_contour->touch();
 
     const skScalar oneOverMaxX = 1.f / (x + w - x);
     const skScalar oneOverMaxY = 1.f / (y + h - y);
@@ -479,14 +1287,3 @@ void skPath::makeUV(void)
     const skRectangle rct = m_bounds.getRect();
     makeUV(rct.x, rct.y, rct.width, rct.height);
 }
-
-void skPath::update(void) const
-{
-    if (m_buffer)
-    {
-        m_buffer->write(
-            m_contour->vertices.ptr(),
-            m_contour->vertices.size() * sizeof(skVertex),
-            SK_STREAM_DRAW);
-    }
-}
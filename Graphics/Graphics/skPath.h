@@ -27,6 +27,9 @@
 #include "skContour.h"
 class skVertexBuffer;
 
+// unchanged draws before a path gets its own static buffer
+#define SK_STATIC_PROMOTE_DRAWS 3
+
 class skPath : public skContextObj
 {
 private:
@@ -38,6 +41,34 @@ private:
     SKuint32        m_reserve;
     bool            m_texCoBuilt;
     skVertexBuffer* m_buffer;
+    bool            m_bufferUV;
+    SKuint32        m_drawGeneration;
+    SKuint32        m_drawCount;
+    skPath*         m_fill;
+    SKuint32        m_fillGeneration;
+    SKfillRule      m_fillRule;
+    bool            m_convex;
+    skPath*         m_stroke;
+    SKuint32        m_strokeGeneration;
+    skScalar        m_strokeWidth;
+    SKpenJoin       m_strokeJoin;
+    SKpenCap        m_strokeCap;
+    bool            m_strokeList;
+
+    skArray<skScalar> m_lengths;
+    SKuint32          m_lengthGeneration;
+    bool              m_lengthList;
+    skPath*           m_dash;
+    SKuint32          m_dashGeneration;
+    skArray<skScalar> m_dashPattern;
+    skScalar          m_dashPhase;
+    bool              m_dashList;
+
+    SKsimplifyMode m_simplifyMode;
+    skScalar       m_simplifyTolerance;
+    skPath*        m_simple;
+    SKuint32       m_simpleGeneration;
+    skScalar       m_simpleScale;
 
 public:
     skPath();
@@ -47,6 +78,9 @@ public:
 
     void setBias(skScalar x, skScalar y);
 
+    // the tolerance is in pixels, see skPathSimplify
+    void setSimplify(SKsimplifyMode mode, skScalar tolerance);
+
     void arcTo(skScalar  x,
                skScalar  y,
                skScalar  w,
@@ -60,11 +94,22 @@ public:
                  skScalar tx,
                  skScalar ty);
 
+    // curves from the current point, with real control points
+    void quadTo(skScalar cx, skScalar cy, skScalar x, skScalar y);
+
+    void bezierTo(skScalar c1x,
+                  skScalar c1y,
+                  skScalar c2x,
+                  skScalar c2y,
+                  skScalar x,
+                  skScalar y);
+
     void rectTo(skScalar fx,
                 skScalar fy,
                 skScalar tx,
                 skScalar ty);
 
+    // starts a new subpath once the path has any vertices
     void moveTo(skScalar x, skScalar y);
 
     void lineTo(skScalar x, skScalar y);
@@ -91,22 +136,74 @@ public:
                      skScalar        scaleY = 1.f,
                      skScalar        biasX  = 0.0,
                      skScalar        biasY  = 0.0);
+    // Adds count points from xy in one pass, with the scale, bias
+    // and metrics worked out once. Unlike lineTo, points that repeat
+    // are kept. The flags are from SKappendFlags.
+    void appendVertices(const skScalar* xy, SKuint32 count, SKuint32 flags);
+
     void close(void);
 
     void clear(void);
 
+    void copy(const skPath& src);
+
+    // applies x' = m[0]x + m[1]y + m[2], y' = m[3]x + m[4]y + m[5]
+    void transform(const skScalar* m);
+
+    // Uploads the vertices to a buffer of their own. Without
+    // texture coordinates only the positions are kept.
+    void makeStatic(bool texCoords = true);
+
     void makeUV(void);
 
     void makeUV(skScalar x, skScalar y, skScalar w, skScalar h);
 
+    // only static paths keep their own buffer, the renderer
+    // streams everything else
     skVertexBuffer* getBuffer(void) const
     {
-        update();
-        return m_buffer;
+        return isStatic() ? m_buffer : nullptr;
+    }
+
+    // Counts a draw and returns the buffer to draw from. A path
+    // drawn unchanged SK_STATIC_PROMOTE_DRAWS times is made static.
+    skVertexBuffer* getDrawBuffer(bool texCoords);
+
+    bool isStatic(void) const;
+
+    // a simple convex polygon fills the same as its fan
+    bool isConvex(void);
+
+    // Returns the path to fill with the rule. Convex paths fill
+    // as a fan of their own vertices, anything else is drawn from
+    // a triangle list that is kept until the path or rule changes.
+    skPath* getFillPath(SKfillRule rule);
+
+    SKuint32 getGeneration(void) const
+    {
+        return m_contour->generation;
     }
 
+    // Returns the outline widened by the pen as a triangle list,
+    // kept until the path or any of the pen settings change. A
+    // list strokes each pair of vertices on its own.
+    skPath* getStrokePath(skScalar width, SKpenJoin join, SKpenCap cap, bool list);
+
+    // Returns the dashes cut from the outline as a line list. The
+    // arc length is measured once per change to the path, so a new
+    // pattern or phase only cuts the dashes again.
+    skPath* getDashPath(const skArray<skScalar>& pattern, skScalar phase, bool list);
+
+    // Returns the path reduced by the simplify mode. It is kept
+    // until the path changes or it is drawn at another scale.
+    skPath* getSimplePath(void);
+
     void addVertex(const skVertex& v);
 
+    // Adds two triangles that share the a-c edge. The path is
+    // then an indexed triangle list.
+    void addQuad(const skVertex& a, const skVertex& b, const skVertex& c, const skVertex& d);
+
     skContour* getContour(void) const
     {
         return m_contour;
@@ -124,13 +221,38 @@ public:
 
 
 protected:
-    void update() const;
-
     void rectCurveTo(skScalar x, skScalar y, skScalar w, skScalar h, skScalar angle1, skScalar angle2);
 
     void pushVertex(const skVertex& v);
 
     void pushLine(skScalar x, skScalar y);
+
+    // a move that is skipped when the path is already there
+    void moveFrom(skScalar x, skScalar y);
+
+    void validateBuffer(bool texCoords);
+
+    // Fills m_lengths with the distance along the outline to each
+    // vertex. Each pair of a list is measured from its own start.
+    void measure(bool list);
+
+    // the vertices of one subpath that stay after simplifying
+    void simplifyRDP(SKuint32 first, SKuint32 count, skScalar tolerance);
+
+    void simplifyMinMax(SKuint32 first, SKuint32 count, skScalar width);
+
+    // adds the outline between the two distances as line pairs
+    void addDash(skScalar from, skScalar to, SKuint32 last, SKuint32& cur);
+
+    // The largest scale from path units to pixels. Without
+    // path units it starts from the stored vertices instead.
+    skScalar getDeviceScale(bool pathUnits = true) const;
+
+    // vertices for an arc of the radius that sweeps the angle
+    SKint32 getArcSegments(skScalar radius, skScalar angle, bool pathUnits = true) const;
+
+    // vertices for a bezier curve with degree + 1 control points
+    SKint32 getCurveSegments(const skVector2* points, SKint32 degree) const;
 };
 
 #endif  //_skPath_h_
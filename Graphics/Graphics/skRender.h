@@ -43,6 +43,16 @@ public:
 
     virtual void stroke(skPath* pth) = 0;
 
+    // Draws pth once per 2x3 affine transform, in its own colour
+    // when colors is set. Returns false when the context should
+    // fill each instance instead.
+    virtual bool fillInstanced(skPath*         pth,
+                               const skScalar* transforms,
+                               const SKuint32* colors,
+                               SKuint32        count) = 0;
+
+    virtual void flush(void) = 0;
+
     virtual void selectPaint(skPaint* paint) = 0;
 
     virtual void projectBox(skScalar x1, skScalar y1, skScalar x2, skScalar y2) = 0;
@@ -50,6 +60,23 @@ public:
     virtual void displayString(skFont* font, const char* str, SKuint32 len, skScalar x, skScalar y) = 0;
 
     virtual void displayString(skCachedString* str) = 0;
+
+    virtual void displayString(skFont* font, skPath* path) = 0;
+
+    virtual skTexture* getTarget(void) = 0;
+
+    virtual void bindTarget(skTexture* target) = 0;
+
+    virtual void resolveTarget(skTexture* target) = 0;
+
+    virtual void readPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* dest) = 0;
+
+    virtual void getStateCalls(SKuint32& issued, SKuint32& skipped) const = 0;
+
+    virtual void resetStateCalls(void) = 0;
+
+    // anything cached about the back end's state is read again
+    virtual void invalidateState(void) = 0;
 };
 
 
@@ -0,0 +1,263 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skStroker.h"
+
+// points closer than this are merged
+#define SK_STROKE_EPSILON skScalar(1e-4)
+
+static skScalar skStrokeCross(const skVector2& a, const skVector2& b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+static skScalar skStrokeDot(const skVector2& a, const skVector2& b)
+{
+    return a.x * b.x + a.y * b.y;
+}
+
+static skVector2 skStrokeDirection(const skVector2& a, const skVector2& b)
+{
+    const skVector2 d = b - a;
+    return d / d.length();
+}
+
+skStroker::skStroker(skScalar width, SKpenJoin join, SKpenCap cap, SKint32 roundSegments) :
+    m_halfWidth(width * skScalar(0.5)),
+    m_join(join),
+    m_cap(cap),
+    m_roundSegments(skMax<SKint32>(roundSegments, 2)),
+    m_out(nullptr)
+{
+}
+
+SKuint32 skStroker::addVertex(const skVector2& v)
+{
+    const SKuint32 index = m_out->vertices.size();
+    m_out->push_back(skVertex(v.x, v.y));
+    return index;
+}
+
+void skStroker::addTriangle(SKuint32 a, SKuint32 b, SKuint32 c)
+{
+    const skVertex& va = m_out->vertices[a];
+    const skVertex& vb = m_out->vertices[b];
+    const skVertex& vc = m_out->vertices[c];
+
+    // Every triangle winds the same way, so the non-zero
+    // rule covers the overlaps at joins and caps only once.
+    const skScalar area = (vb.x - va.x) * (vc.y - va.y) - (vc.x - va.x) * (vb.y - va.y);
+
+    m_out->indices.push_back(a);
+    if (area < 0)
+    {
+        m_out->indices.push_back(c);
+        m_out->indices.push_back(b);
+    }
+    else
+    {
+        m_out->indices.push_back(b);
+        m_out->indices.push_back(c);
+    }
+}
+
+void skStroker::addSegment(const skVector2& a, const skVector2& b)
+{
+    const skVector2 d = skStrokeDirection(a, b);
+    const skVector2 n(-d.y * m_halfWidth, d.x * m_halfWidth);
+
+    const SKuint32 i0 = addVertex(a + n);
+    const SKuint32 i1 = addVertex(b + n);
+    const SKuint32 i2 = addVertex(b - n);
+    const SKuint32 i3 = addVertex(a - n);
+
+    addTriangle(i0, i1, i2);
+    addTriangle(i2, i3, i0);
+}
+
+void skStroker::addArc(const skVector2& p, const skVector2& from, const skVector2& to, skScalar dir)
+{
+    // a fan around p that turns from one offset to the other
+    const skScalar step = dir * skPi / skScalar(m_roundSegments);
+
+    skScalar s, c;
+    skMath::sinCos(step, s, c);
+
+    const SKuint32 center = addVertex(p);
+
+    skVector2 cur  = from;
+    SKuint32  prev = addVertex(p + from);
+    for (SKint32 i = 0; i < m_roundSegments * 2; ++i)
+    {
+        const skVector2 next(cur.x * c - cur.y * s, cur.x * s + cur.y * c);
+        if (skStrokeCross(next, to) * dir <= 0)
+            break;
+
+        const SKuint32 index = addVertex(p + next);
+        addTriangle(center, prev, index);
+
+        prev = index;
+        cur  = next;
+    }
+
+    addTriangle(center, prev, addVertex(p + to));
+}
+
+void skStroker::addJoin(const skVector2& p, const skVector2& d0, const skVector2& d1)
+{
+    const skScalar turn = skStrokeCross(d0, d1);
+    if (skAbs(turn) < SK_STROKE_EPSILON && skStrokeDot(d0, d1) > 0)
+        return;
+
+    // the gap opens on the outside of the turn
+    const skScalar  side = turn > 0 ? skScalar(-1) : skScalar(1);
+    const skVector2 n0(-d0.y * m_halfWidth * side, d0.x * m_halfWidth * side);
+    const skVector2 n1(-d1.y * m_halfWidth * side, d1.x * m_halfWidth * side);
+
+    if (m_join == SK_JOIN_ROUND)
+    {
+        // the short way round, or forward when the line doubles back
+        skScalar dir = turn;
+        if (skAbs(turn) < SK_STROKE_EPSILON)
+            dir = skStrokeCross(n0, d0);
+
+        addArc(p, n0, n1, dir > 0 ? skScalar(1) : skScalar(-1));
+        return;
+    }
+
+    const SKuint32 center = addVertex(p);
+    const SKuint32 a      = addVertex(p + n0);
+    const SKuint32 b      = addVertex(p + n1);
+
+    if (m_join == SK_JOIN_MITER)
+    {
+        // the tip is along the bisector, at 1 / cos(half the
+        // angle between the offsets) half widths
+        const skVector2 mid = n0 + n1;
+        const skScalar  len = mid.length();
+        if (len > SK_STROKE_EPSILON)
+        {
+            const skVector2 m        = mid / len;
+            const skScalar  cosHalf  = skStrokeDot(m, n0) / m_halfWidth;
+            const skScalar  miterLen = cosHalf > SK_STROKE_EPSILON ? 1 / cosHalf : 0;
+
+            if (miterLen > 0 && miterLen <= skScalar(SK_MITER_LIMIT))
+            {
+                const SKuint32 tip = addVertex(p + m * (m_halfWidth * miterLen));
+                addTriangle(center, a, tip);
+                addTriangle(center, tip, b);
+                return;
+            }
+        }
+    }
+
+    addTriangle(center, a, b);
+}
+
+void skStroker::addCap(const skVector2& p, const skVector2& d)
+{
+    // d points away from the line
+    const skVector2 n(-d.y * m_halfWidth, d.x * m_halfWidth);
+
+    if (m_cap == SK_CAP_SQUARE)
+    {
+        const skVector2 e = d * m_halfWidth;
+
+        const SKuint32 i0 = addVertex(p + n);
+        const SKuint32 i1 = addVertex(p + n + e);
+        const SKuint32 i2 = addVertex(p - n + e);
+        const SKuint32 i3 = addVertex(p - n);
+
+        addTriangle(i0, i1, i2);
+        addTriangle(i2, i3, i0);
+    }
+    else if (m_cap == SK_CAP_ROUND)
+        addArc(p, n, n * skScalar(-1), skStrokeCross(n, d) > 0 ? skScalar(1) : skScalar(-1));
+}
+
+void skStroker::stroke(const skVertex* pts, SKuint32 count, skContour& out)
+{
+    if (!pts || count < 2 || m_halfWidth <= 0)
+        return;
+
+    m_out = &out;
+
+    m_points.resizeFast(0);
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        if (!m_points.empty())
+        {
+            const skVertex& last = m_points[m_points.size() - 1];
+            if (skEqT(last.x, pts[i].x, SK_STROKE_EPSILON) &&
+                skEqT(last.y, pts[i].y, SK_STROKE_EPSILON))
+                continue;
+        }
+        m_points.push_back(pts[i]);
+    }
+
+    SKuint32 nr = m_points.size();
+    if (nr < 2)
+        return;
+
+    const skVertex& first  = m_points[0];
+    const skVertex& last   = m_points[nr - 1];
+    const bool      closed = nr > 3 &&
+                        skEqT(first.x, last.x, SK_STROKE_EPSILON) &&
+                        skEqT(first.y, last.y, SK_STROKE_EPSILON);
+    if (closed)
+        --nr;
+
+    const SKuint32 nrSegments = closed ? nr : nr - 1;
+    for (SKuint32 i = 0; i < nrSegments; ++i)
+    {
+        const skVertex& a = m_points[i];
+        const skVertex& b = m_points[(i + 1) % nr];
+        addSegment(skVector2(a.x, a.y), skVector2(b.x, b.y));
+    }
+
+    // joins at every vertex with a segment on both sides
+    const SKuint32 firstJoin = closed ? 0 : 1;
+    const SKuint32 lastJoin  = closed ? nr : nr - 1;
+    for (SKuint32 i = firstJoin; i < lastJoin; ++i)
+    {
+        const skVertex& a = m_points[(i + nr - 1) % nr];
+        const skVertex& b = m_points[i];
+        const skVertex& c = m_points[(i + 1) % nr];
+
+        const skVector2 pb(b.x, b.y);
+        addJoin(pb,
+                skStrokeDirection(skVector2(a.x, a.y), pb),
+                skStrokeDirection(pb, skVector2(c.x, c.y)));
+    }
+
+    if (!closed)
+    {
+        const skVector2 p0(m_points[0].x, m_points[0].y);
+        const skVector2 p1(m_points[1].x, m_points[1].y);
+        const skVector2 q0(m_points[nr - 2].x, m_points[nr - 2].y);
+        const skVector2 q1(m_points[nr - 1].x, m_points[nr - 1].y);
+
+        addCap(p0, skStrokeDirection(p1, p0));
+        addCap(q1, skStrokeDirection(q0, q1));
+    }
+
+    m_out = nullptr;
+}
@@ -0,0 +1,65 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skStroker_h_
+#define _skStroker_h_
+
+#include "skContour.h"
+
+// miter joins longer than this many half widths are beveled
+#define SK_MITER_LIMIT 4
+
+// Turns polylines into an indexed triangle list that covers
+// them at the pen width, with the joins and caps added. The
+// triangles all wind the same way and overlap where they meet.
+class skStroker
+{
+private:
+    skScalar   m_halfWidth;
+    SKpenJoin  m_join;
+    SKpenCap   m_cap;
+    SKint32    m_roundSegments;
+    skContour* m_out;
+    skPoly     m_points;
+
+public:
+    // round joins and caps use roundSegments per half turn
+    skStroker(skScalar width, SKpenJoin join, SKpenCap cap, SKint32 roundSegments);
+
+    // Appends the stroke of the polyline to out. One
+    // that ends where it started is joined all the way round.
+    void stroke(const skVertex* pts, SKuint32 count, skContour& out);
+
+private:
+    SKuint32 addVertex(const skVector2& v);
+
+    void addTriangle(SKuint32 a, SKuint32 b, SKuint32 c);
+
+    void addSegment(const skVector2& a, const skVector2& b);
+
+    void addJoin(const skVector2& p, const skVector2& d0, const skVector2& d1);
+
+    void addCap(const skVector2& p, const skVector2& d);
+
+    void addArc(const skVector2& p, const skVector2& from, const skVector2& to, skScalar dir);
+};
+
+#endif  //_skStroker_h_
@@ -0,0 +1,369 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include "skTessellator.h"
+
+// bands thinner than this are dropped
+#define SK_TESS_EPSILON skScalar(1e-4)
+
+static void skTessSortEdges(SKtessEdge* edges, SKuint32 count)
+{
+    for (SKuint32 gap = count / 2; gap > 0; gap /= 2)
+    {
+        for (SKuint32 i = gap; i < count; ++i)
+        {
+            const SKtessEdge edge = edges[i];
+
+            SKuint32 j = i;
+            while (j >= gap && edges[j - gap].top.y > edge.top.y)
+            {
+                edges[j] = edges[j - gap];
+                j -= gap;
+            }
+            edges[j] = edge;
+        }
+    }
+}
+
+static void skTessSortScalars(skScalar* values, SKuint32 count)
+{
+    for (SKuint32 gap = count / 2; gap > 0; gap /= 2)
+    {
+        for (SKuint32 i = gap; i < count; ++i)
+        {
+            const skScalar value = values[i];
+
+            SKuint32 j = i;
+            while (j >= gap && values[j - gap] > value)
+            {
+                values[j] = values[j - gap];
+                j -= gap;
+            }
+            values[j] = value;
+        }
+    }
+}
+
+static skScalar skTessCross(skScalar ax, skScalar ay, skScalar bx, skScalar by)
+{
+    return ax * by - ay * bx;
+}
+
+void skTessellator::clear(void)
+{
+    m_edges.resizeFast(0);
+    m_ys.resizeFast(0);
+    m_crossings.resizeFast(0);
+    m_active.resizeFast(0);
+}
+
+void skTessellator::addContour(const skVertex* pts, SKuint32 count)
+{
+    if (!pts || count < 3)
+        return;
+
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        const skVertex& a = pts[i];
+        const skVertex& b = pts[(i + 1) % count];
+
+        // horizontal edges never change the winding
+        if (skEqT(a.y, b.y, SK_TESS_EPSILON))
+            continue;
+
+        SKtessEdge edge;
+        if (a.y < b.y)
+        {
+            edge.top    = a;
+            edge.bottom = b;
+            edge.dir    = 1;
+        }
+        else
+        {
+            edge.top    = b;
+            edge.bottom = a;
+            edge.dir    = -1;
+        }
+        edge.lastY     = 0;
+        edge.lastIndex = SK_NPOS32;
+        m_edges.push_back(edge);
+    }
+}
+
+void skTessellator::findCrossings(void)
+{
+    // The edges are sorted by their top, so each new edge only
+    // has to be tested against the edges still open where it
+    // starts. Those that end above it are retired as it goes.
+    m_active.resizeFast(0);
+
+    const SKuint32 nrEdges = m_edges.size();
+    for (SKuint32 i = 0; i < nrEdges; ++i)
+    {
+        const SKtessEdge& b = m_edges[i];
+
+        const skScalar sx = b.bottom.x - b.top.x;
+        const skScalar sy = b.bottom.y - b.top.y;
+
+        SKuint32 nrActive = 0;
+        for (SKuint32 j = 0; j < m_active.size(); ++j)
+        {
+            const SKtessEdge& a = m_edges[m_active[j]];
+            if (a.bottom.y <= b.top.y)
+                continue;
+            m_active[nrActive++] = m_active[j];
+
+            const skScalar rx = a.bottom.x - a.top.x;
+            const skScalar ry = a.bottom.y - a.top.y;
+
+            const skScalar den = skTessCross(rx, ry, sx, sy);
+            if (skIsZero(den))
+                continue;
+
+            const skScalar qx = b.top.x - a.top.x;
+            const skScalar qy = b.top.y - a.top.y;
+
+            const skScalar t = skTessCross(qx, qy, sx, sy) / den;
+            const skScalar u = skTessCross(qx, qy, rx, ry) / den;
+            if (t > 0 && t < 1 && u > 0 && u < 1)
+                m_ys.push_back(a.top.y + t * ry);
+        }
+        m_active.resizeFast(nrActive);
+        m_active.push_back(i);
+    }
+}
+
+SKuint32 skTessellator::vertexOn(SKtessEdge& edge, skScalar y, skContour& out) const
+{
+    // the bottom of one band is the top of the next
+    if (edge.lastIndex != SK_NPOS32 && edge.lastY == y)
+        return edge.lastIndex;
+
+    const skScalar t = skClamp<skScalar>(
+        (y - edge.top.y) / (edge.bottom.y - edge.top.y),
+        0,
+        1);
+
+    skVertex v;
+    v.x = edge.top.x + (edge.bottom.x - edge.top.x) * t;
+    v.y = y;
+    v.u = edge.top.u + (edge.bottom.u - edge.top.u) * t;
+    v.v = edge.top.v + (edge.bottom.v - edge.top.v) * t;
+
+    edge.lastY     = y;
+    edge.lastIndex = out.vertices.size();
+    out.push_back(v);
+    return edge.lastIndex;
+}
+
+void skTessellator::tessellate(SKfillRule rule, skContour& out)
+{
+    out.clear();
+
+    const SKuint32 nrEdges = m_edges.size();
+    if (nrEdges < 2)
+        return;
+
+    skTessSortEdges(m_edges.ptr(), nrEdges);
+
+    m_ys.resizeFast(0);
+    for (SKuint32 i = 0; i < nrEdges; ++i)
+    {
+        m_ys.push_back(m_edges[i].top.y);
+        m_ys.push_back(m_edges[i].bottom.y);
+    }
+    findCrossings();
+
+    skTessSortScalars(m_ys.ptr(), m_ys.size());
+
+    SKuint32 nrYs = 1;
+    for (SKuint32 i = 1; i < m_ys.size(); ++i)
+    {
+        if (m_ys[i] - m_ys[nrYs - 1] > SK_TESS_EPSILON)
+            m_ys[nrYs++] = m_ys[i];
+    }
+
+    // The active edges are the ones that span the current band.
+    // Edges join from the sorted list as the sweep reaches their
+    // top and are retired once it passes their bottom. They are
+    // kept in the order of the last band, which only changes
+    // where two of them cross, so the sort below has little to do.
+    m_active.resizeFast(0);
+
+    SKuint32 next = 0;
+    for (SKuint32 k = 0; k + 1 < nrYs; ++k)
+    {
+        const skScalar ya = m_ys[k];
+        const skScalar yb = m_ys[k + 1];
+        const skScalar ym = (ya + yb) * skScalar(0.5);
+
+        SKuint32 nrActive = 0;
+        for (SKuint32 i = 0; i < m_active.size(); ++i)
+        {
+            if (m_edges[m_active[i]].bottom.y >= ym)
+                m_active[nrActive++] = m_active[i];
+        }
+        m_active.resizeFast(nrActive);
+
+        while (next < nrEdges && m_edges[next].top.y <= ym)
+        {
+            if (m_edges[next].bottom.y >= ym)
+                m_active.push_back(next);
+            ++next;
+        }
+
+        // nothing crosses inside a band, so the order
+        // in the middle holds from the top to the bottom
+        m_crossings.resizeFast(0);
+        for (SKuint32 i = 0; i < m_active.size(); ++i)
+        {
+            const SKtessEdge& edge = m_edges[m_active[i]];
+
+            SKtessCrossing cross;
+            cross.edge = m_active[i];
+            cross.x    = edge.top.x + (edge.bottom.x - edge.top.x) *
+                                       (ym - edge.top.y) / (edge.bottom.y - edge.top.y);
+
+            m_crossings.push_back(cross);
+
+            SKuint32 j = m_crossings.size() - 1;
+            while (j > 0 && m_crossings[j - 1].x > cross.x)
+            {
+                m_crossings[j] = m_crossings[j - 1];
+                --j;
+            }
+            m_crossings[j] = cross;
+        }
+
+        for (SKuint32 i = 0; i < m_crossings.size(); ++i)
+            m_active[i] = m_crossings[i].edge;
+
+        SKint32        winding = 0;
+        SKuint32       left    = 0;
+        const SKuint32 nrCross = m_crossings.size();
+        for (SKuint32 i = 0; i < nrCross; ++i)
+        {
+            const SKtessCrossing& cross = m_crossings[i];
+
+            const bool was = rule == SK_EVEN_ODD ? (winding & 1) != 0 : winding != 0;
+            winding += m_edges[cross.edge].dir;
+            const bool is = rule == SK_EVEN_ODD ? (winding & 1) != 0 : winding != 0;
+
+            if (!was && is)
+                left = cross.edge;
+            else if (was && !is)
+            {
+                SKtessEdge& l = m_edges[left];
+                SKtessEdge& r = m_edges[cross.edge];
+
+                const SKuint32 la = vertexOn(l, ya, out);
+                const SKuint32 ra = vertexOn(r, ya, out);
+                const SKuint32 lb = vertexOn(l, yb, out);
+                const SKuint32 rb = vertexOn(r, yb, out);
+
+                const skPoly& v = out.vertices;
+
+                // a band that closes to a point is one triangle
+                const bool top    = v[ra].x - v[la].x > SK_TESS_EPSILON;
+                const bool bottom = v[rb].x - v[lb].x > SK_TESS_EPSILON;
+
+                skIndices& indices = out.indices;
+                if (top)
+                {
+                    indices.push_back(la);
+                    indices.push_back(ra);
+                    indices.push_back(bottom ? rb : lb);
+                }
+                if (bottom)
+                {
+                    indices.push_back(rb);
+                    indices.push_back(lb);
+                    indices.push_back(la);
+                }
+            }
+        }
+    }
+
+    // vertices that no triangle uses are left in place
+    if (out.indices.empty())
+        out.clear();
+}
+
+bool skTessellator::isConvex(const skVertex* pts, SKuint32 count)
+{
+    if (!pts)
+        return false;
+
+    // a closed path repeats its first vertex
+    while (count > 1 &&
+           skEqT(pts[count - 1].x, pts[0].x, SK_TESS_EPSILON) &&
+           skEqT(pts[count - 1].y, pts[0].y, SK_TESS_EPSILON))
+        --count;
+
+    if (count < 4)
+        return true;
+
+    // start from the direction of the last edge that moves in x
+    SKint32 prevX = 0;
+    for (SKuint32 i = count; i > 0 && prevX == 0; --i)
+    {
+        const skScalar dx = pts[i % count].x - pts[i - 1].x;
+        if (dx > SK_TESS_EPSILON)
+            prevX = 1;
+        else if (dx < -SK_TESS_EPSILON)
+            prevX = -1;
+    }
+
+    SKint32 turn  = 0;
+    SKint32 flips = 0;
+    for (SKuint32 i = 0; i < count; ++i)
+    {
+        const skVertex& a = pts[i];
+        const skVertex& b = pts[(i + 1) % count];
+        const skVertex& c = pts[(i + 2) % count];
+
+        const skScalar cross = skTessCross(b.x - a.x, b.y - a.y, c.x - b.x, c.y - b.y);
+
+        // every corner has to turn the same way
+        const SKint32 sign = cross > SK_TESS_EPSILON ? 1 : cross < -SK_TESS_EPSILON ? -1 : 0;
+        if (sign != 0)
+        {
+            if (turn == 0)
+                turn = sign;
+            else if (sign != turn)
+                return false;
+        }
+
+        const skScalar dx = b.x - a.x;
+
+        const SKint32 dirX = dx > SK_TESS_EPSILON ? 1 : dx < -SK_TESS_EPSILON ? -1 : 0;
+        if (dirX != 0)
+        {
+            if (dirX != prevX)
+                ++flips;
+            prevX = dirX;
+        }
+    }
+
+    // and a polygon that winds around more than once
+    // turns back in x more than twice
+    return flips <= 2;
+}
@@ -0,0 +1,78 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#ifndef _skTessellator_h_
+#define _skTessellator_h_
+
+#include "skContour.h"
+
+typedef struct SKtessEdge
+{
+    // top.y < bottom.y
+    skVertex top, bottom;
+    SKint32  dir;
+    // the vertex last written on this edge
+    skScalar lastY;
+    SKuint32 lastIndex;
+} SKtessEdge;
+
+typedef struct SKtessCrossing
+{
+    SKuint32 edge;
+    skScalar x;
+} SKtessCrossing;
+
+// Splits the area inside a set of closed contours into
+// trapezoids, by sweeping down through every vertex and
+// every point where two edges cross. Inside each band the
+// edges keep their order, so the spans that pass the fill
+// rule can be written out as quads.
+class skTessellator
+{
+private:
+    skArray<SKtessEdge>     m_edges;
+    skArray<skScalar>       m_ys;
+    skArray<SKtessCrossing> m_crossings;
+    skArray<SKuint32>       m_active;
+
+public:
+    skTessellator() = default;
+
+    void clear(void);
+
+    // the last vertex joins back to the first
+    void addContour(const skVertex* pts, SKuint32 count);
+
+    // Writes the filled area as an indexed triangle list, with
+    // texture coordinates interpolated along the edges.
+    void tessellate(SKfillRule rule, skContour& out);
+
+    // True when the points make a simple convex polygon, which
+    // fills the same as a fan under either rule.
+    static bool isConvex(const skVertex* pts, SKuint32 count);
+
+private:
+    void findCrossings(void);
+
+    SKuint32 vertexOn(SKtessEdge& edge, skScalar y, skContour& out) const;
+};
+
+#endif  //_skTessellator_h_
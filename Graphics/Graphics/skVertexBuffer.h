@@ -23,6 +23,7 @@
 #define _skVertexBuffer_h_
 
 #include "Utils/skArray.h"
+#include "skContour.h"
 
 typedef enum skAttribute
 {
@@ -30,6 +31,8 @@ typedef enum skAttribute
     SK_ATTR_TEXTURE0,
     SK_ATTR_NORMAL,
     SK_ATTR_COLORS,
+    SK_ATTR_TRANSFORM0,  // per instance affine rows
+    SK_ATTR_TRANSFORM1,
 } skAttribute;
 
 typedef enum skAttributeType
@@ -39,8 +42,19 @@ typedef enum skAttributeType
     SK_FLOAT3_32,      //!< sizeof(float)*3
     SK_FLOAT4_32,      //!< sizeof(float)*4
     SK_UINT1_32,       //!< sizeof(int)  *1
+    SK_HALF2_16,       //!< sizeof(short)*2, half float
+    SK_HALF4_16,       //!< sizeof(short)*4, half float
+    SK_SHORT2_16N,     //!< sizeof(short)*2, normalized to [-1, 1]
+    SK_USHORT2_16N,    //!< sizeof(short)*2, normalized to [0, 1]
+    SK_UBYTE4_8N,      //!< sizeof(char) *4, normalized to [0, 1]
 } skAttributeType;
 
+typedef enum skIndexType
+{
+    SK_INDEX_16,
+    SK_INDEX_32,
+} skIndexType;
+
 typedef enum skBufferMode
 {
     SK_STREAM_DRAW,
@@ -56,14 +70,38 @@ typedef enum skBufferMode
 
 class skVertexBuffer
 {
+protected:
+    SKuint32 m_generation = SK_NPOS32;
+
 public:
     skVertexBuffer()  = default;
     virtual ~skVertexBuffer() = default;
 
+    // the contour generation that was last written
+    SKuint32 getGeneration(void) const
+    {
+        return m_generation;
+    }
+
+    void setGeneration(SKuint32 generation)
+    {
+        m_generation = generation;
+    }
+
+    // Returns the new stride, or zero when the back end
+    // cannot read the type, such as half floats on ES 2
+    // without OES_vertex_half_float.
     virtual SKsize addElement(SKuint32 name, SKuint32 type) = 0;
 
     virtual void write(const void* ptr, const SKuint32& sizeInBytes, const SKint32& mode) = 0;
 
+    // Converts the vertices to the element layout before writing.
+    // Positions feed SK_ATTR_POSITION and u, v feed SK_ATTR_TEXTURE0.
+    virtual void writeVertices(const skVertex* ptr, const SKuint32& count, const SKint32& mode) = 0;
+
+    // once indices are written, fill draws with them
+    virtual void writeIndices(const SKuint32* ptr, const SKuint32& count, const SKint32& mode) = 0;
+
     virtual void fill(SKuint32 op) const = 0;
 };
 
@@ -145,6 +145,9 @@ public:
             if (m_call->paint)
             {
                 m_call->paint((SKwindow)caller, m_call->user);
+
+                // draw anything still batched before swapping
+                skFlush();
                 caller->flush();
             }
             break;
@@ -35,6 +35,8 @@ SK_ST_C;
 #define SK_MAX_VERTICES_PER_SEGMENT 128
 #define SK_DEFAULT_PROJECTION_MODE SK_STANDARD
 #define SK_DEFAULT_METRICS_MODE SK_PIXEL
+#define SK_DEFAULT_WORKER_THREADS 1
+#define SK_MAX_WORKER_THREADS 64
 #define SK_MIN_DPI 24
 #define SK_MAX_DPI 300
 #define SK_MIN_FONT_SIZE 8
@@ -52,11 +54,13 @@ SK_SIZE_HANDLE(SKpath);
 SK_SIZE_HANDLE(SKimage);
 SK_SIZE_HANDLE(SKfont);
 SK_SIZE_HANDLE(SKcachedString);
+SK_SIZE_HANDLE(SKlist);
 
 enum SKbackend
 {
     SK_BE_None,
     SK_BE_OpenGL,
+    SK_BE_Software,
 };
 
 typedef skScalar SKscalar;
@@ -159,6 +163,11 @@ enum SKPaintStyle
     SK_BRUSH_PATTERN,
     SK_LINE_TYPE,
     SK_AUTO_CLEAR,
+    SK_FILL_RULE,
+    SK_FILL_MODE,
+    SK_PEN_JOIN,
+    SK_PEN_CAP,
+    SK_DASH_PHASE,
 };
 
 typedef SKenum SKpaintStyle;
@@ -189,6 +198,13 @@ enum SKContextOptionEnum
     SK_USE_CURRENT_VIEWPORT,
     SK_PROJECTION_TYPE,
     SK_Y_UP,
+    SK_WORKER_THREADS,
+    SK_ANTI_ALIAS,
+    SK_BATCH_DRAWS,
+    SK_REORDER_DRAWS,
+    SK_STATE_CALLS,
+    SK_STATE_CALLS_SKIPPED,
+    SK_FLATTEN_TOLERANCE,
 };
 
 typedef SKenum SKcontextOptionEnum;
@@ -218,6 +234,54 @@ enum SKLineType
 };
 typedef SKenum SKlineType;
 
+enum SKFillRule
+{
+    SK_FR_MIN,
+    SK_NON_ZERO,
+    SK_EVEN_ODD,
+    SK_FR_MAX,
+};
+typedef SKenum SKfillRule;
+
+enum SKFillMode
+{
+    SK_FM_MIN,
+    SK_FILL_TESSELLATE,
+    SK_FILL_STENCIL,
+    SK_FM_MAX,
+};
+typedef SKenum SKfillMode;
+
+enum SKSimplifyMode
+{
+    SK_SM_MIN,
+    SK_SIMPLIFY_NONE,
+    SK_SIMPLIFY_RDP,
+    SK_SIMPLIFY_MIN_MAX,
+    SK_SM_MAX,
+};
+typedef SKenum SKsimplifyMode;
+
+enum SKPenJoin
+{
+    SK_PJ_MIN,
+    SK_JOIN_MITER,
+    SK_JOIN_ROUND,
+    SK_JOIN_BEVEL,
+    SK_PJ_MAX,
+};
+typedef SKenum SKpenJoin;
+
+enum SKPenCap
+{
+    SK_PC_MIN,
+    SK_CAP_BUTT,
+    SK_CAP_ROUND,
+    SK_CAP_SQUARE,
+    SK_PC_MAX,
+};
+typedef SKenum SKpenCap;
+
 enum SKCorner
 {
     SK_CNR_NONE = 0,
@@ -229,6 +293,14 @@ enum SKCorner
 };
 typedef SKenum SKcorner;
 
+enum SKAppendFlags
+{
+    SK_APPEND_LINE  = 0,
+    SK_APPEND_MOVE  = 0x01,
+    SK_APPEND_CLOSE = 0x02,
+};
+typedef SKenum SKappendFlags;
+
 enum SKDirection
 {
     SK_NORTH = 0x01,
@@ -308,8 +380,14 @@ SK_API SKcontext skNewBackEndContext(SKenum backend);
 SK_API void      skDeleteContext(SKcontext ctx);
 SK_API void      skSetCurrentContext(SKcontext ctx);
 SK_API SKcontext skGetCurrentContext();
+SK_API SKimage   skGetContextImage();
 SK_API void      skClearContext();
 SK_API void      skClear(SKscalar x, SKscalar y, SKscalar w, SKscalar h);
+SK_API void      skFlush();
+
+// Forgets the GL state the context keeps track of, for when
+// other code has drawn into the same GL context in between.
+SK_API void skInvalidateState();
 
 SK_API void skSetContext1i(SKcontextOptionEnum en, SKint32 v);
 SK_API void skSetContext1f(SKcontextOptionEnum en, SKscalar v);
@@ -370,6 +448,9 @@ SK_API void skGetPaint1i(SKpaintStyle en, SKint32* v);
 SK_API void skGetPaint1f(SKpaintStyle en, SKscalar* v);
 SK_API void skGetPaint1ui(SKpaintStyle en, SKuint32* v);
 
+// alternating on and off lengths for SK_PS_DASHED
+SK_API void skSetPaintDashes(const SKscalar* pattern, SKint32 count);
+
 /**********************************************************
    Images
 */
@@ -380,6 +461,10 @@ SK_API void    skSelectImage(SKimage ima);
 
 SK_API SKimage skCreateImage(SKuint32 w, SKuint32 h, SKint32 format);
 
+SK_API SKimage skNewRenderTarget(SKuint32 w, SKuint32 h, SKint32 format);
+SK_API void    skBindRenderTarget(SKimage ima);
+SK_API void    skReadPixels(SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* pixels);
+
 SK_API void skImageLinearGradient(SKimage      ima,
                                   SKcolorStop* stops,
                                   SKint32      stopCount,
@@ -462,6 +547,8 @@ SK_API void skLineTo(SKscalar x, SKscalar y);
 SK_API void skPutVert(SKscalar x, SKscalar y, SKuint8 move);
 
 SK_API void skCubicTo(SKscalar fx, SKscalar fy, SKscalar tx, SKscalar ty);
+SK_API void skQuadTo(SKscalar cx, SKscalar cy, SKscalar x, SKscalar y);
+SK_API void skBezierTo(SKscalar c1x, SKscalar c1y, SKscalar c2x, SKscalar c2y, SKscalar x, SKscalar y);
 SK_API void skRectTo(SKscalar fx, SKscalar fy, SKscalar tx, SKscalar ty);
 
 SK_API void skArcTo(SKscalar x1, SKscalar y1, SKscalar x2, SKscalar y2, SKscalar angle1, SKscalar angle2, SKwinding winding);
@@ -469,6 +556,15 @@ SK_API void skArc(SKscalar x, SKscalar y, SKscalar radius, SKscalar angle1, SKsc
 SK_API void skClosePath();
 SK_API void skClearPath();
 
+// Adds count points from xy, two scalars each. The points carry on from
+// the current one unless SK_APPEND_MOVE starts a new subpath with them.
+SK_API void skPathAppend(const SKscalar* xy, SKuint32 count, SKuint32 flags);
+
+// Draws the path with fewer vertices. SK_SIMPLIFY_RDP keeps the outline
+// within tolerance pixels, SK_SIMPLIFY_MIN_MAX keeps the first, last,
+// lowest and highest point in each column tolerance pixels wide.
+SK_API void skPathSimplify(SKsimplifyMode mode, SKscalar tolerance);
+
 /**********************************************************
    Common Polygons
 */
@@ -487,6 +583,11 @@ SK_API void skPolygon(SKscalar* vertices, SKuint32 count, SKuint32 close_);
 SK_API void skFill();
 SK_API void skStroke();
 
+// Fills path count times. Each instance has a 2x3 affine transform
+// of six scalars, x' = t[0]x + t[1]y + t[2], y' = t[3]x + t[4]y + t[5],
+// and, if colors is not null, its own surface color.
+SK_API void skFillInstanced(SKpath path, const SKscalar* transforms, const SKcolori* colors, SKuint32 count);
+
 /**********************************************************
    Strings
 */
@@ -500,6 +601,65 @@ SK_API void           skGetCachedString2fv(const SKcachedString str, SKstringOpt
 SK_API void           skDisplayString(SKfont font, const char* str, SKint32 len, SKscalar x, SKscalar y);
 SK_API void           skDisplayFormattedString(SKfont font, SKscalar x, SKscalar y, const char* str, ...);
 
+/**********************************************************
+   Display lists
+*/
+
+SK_API void   skBeginList();
+SK_API SKlist skEndList();
+SK_API void   skCallList(SKlist list);
+SK_API void   skDeleteList(SKlist list);
+
+/**********************************************************
+   Explicit context
+
+   The current context is per thread. These take the context
+   as the first argument instead, so one thread can drive more
+   than one context without switching between them.
+*/
+
+SK_API void skSetContext1iEx(SKcontext context, SKcontextOptionEnum en, SKint32 v);
+SK_API void skSetContext1fEx(SKcontext context, SKcontextOptionEnum en, SKscalar v);
+SK_API void skGetContext1iEx(SKcontext context, SKcontextOptionEnum en, SKint32* v);
+SK_API void skSetContext2iEx(SKcontext context, SKcontextOptionEnum en, SKint32 i0, SKint32 i1);
+SK_API void skSetContext2fEx(SKcontext context, SKcontextOptionEnum en, SKscalar f0, SKscalar f1);
+
+SK_API void skClearEx(SKcontext context, SKscalar x, SKscalar y, SKscalar w, SKscalar h);
+SK_API void skFlushEx(SKcontext context);
+SK_API void skInvalidateStateEx(SKcontext context);
+SK_API void skProjectContextEx(SKcontext context, SKprojectionType pt);
+SK_API void skReadPixelsEx(SKcontext context, SKint32 x, SKint32 y, SKint32 w, SKint32 h, SKubyte* pixels);
+
+SK_API void skLoadIdentityEx(SKcontext context);
+SK_API void skTranslateEx(SKcontext context, SKscalar x, SKscalar y);
+
+SK_API void skSelectPaintEx(SKcontext context, SKpaint obj);
+SK_API void skColor1uiEx(SKcontext context, SKuint32 c);
+SK_API void skColor4fEx(SKcontext context, SKscalar r, SKscalar g, SKscalar b, SKscalar a);
+SK_API void skSetPaintDashesEx(SKcontext context, const SKscalar* pattern, SKint32 count);
+
+SK_API void skMoveToEx(SKcontext context, SKscalar x, SKscalar y);
+SK_API void skLineToEx(SKcontext context, SKscalar x, SKscalar y);
+SK_API void skCubicToEx(SKcontext context, SKscalar fx, SKscalar fy, SKscalar tx, SKscalar ty);
+SK_API void skQuadToEx(SKcontext context, SKscalar cx, SKscalar cy, SKscalar x, SKscalar y);
+SK_API void skBezierToEx(SKcontext context, SKscalar c1x, SKscalar c1y, SKscalar c2x, SKscalar c2y, SKscalar x, SKscalar y);
+SK_API void skClosePathEx(SKcontext context);
+SK_API void skClearPathEx(SKcontext context);
+SK_API void skPathAppendEx(SKcontext context, const SKscalar* xy, SKuint32 count, SKuint32 flags);
+SK_API void skPathSimplifyEx(SKcontext context, SKsimplifyMode mode, SKscalar tolerance);
+SK_API void skRectEx(SKcontext context, SKscalar x, SKscalar y, SKscalar w, SKscalar h);
+SK_API void skEllipseEx(SKcontext context, SKscalar x, SKscalar y, SKscalar w, SKscalar h);
+
+SK_API void skFillEx(SKcontext context);
+SK_API void skStrokeEx(SKcontext context);
+SK_API void skFillInstancedEx(SKcontext context, SKpath path, const SKscalar* transforms, const SKcolori* colors, SKuint32 count);
+SK_API void skDisplayStringEx(SKcontext context, SKfont font, const char* str, SKint32 len, SKscalar x, SKscalar y);
+
+SK_API SKimage skNewImageEx(SKcontext context);
+SK_API void    skDeleteImageEx(SKcontext context, SKimage ima);
+SK_API SKfont  skNewFontEx(SKcontext context, SKbuiltinFont font, SKuint32 size, SKuint32 dpi);
+SK_API void    skDeleteFontEx(SKcontext context, SKfont font);
+
 #ifndef Graphics_NO_PALETTE
 
 const SKuint32 CS_Grey00           = 0x000000FF;
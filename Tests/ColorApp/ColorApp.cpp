@@ -135,6 +135,7 @@ private:
         skColor1ui(CS_Grey00);
         skStroke();
         skClearPath();
+        skFlush();
         m_window->flush();
     }
 
@@ -380,5 +380,6 @@ void Application::draw()
     skLine(m_size.x / 2, 0, m_size.x / 2, m_size.y);
     skStroke();
 
+    skFlush();
     m_window->flush();
 }
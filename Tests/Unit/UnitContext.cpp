@@ -20,6 +20,7 @@
 -------------------------------------------------------------------------------
 */
 #include "Catch2.h"
+#include "Graphics/Graphics/skBatchList.h"
 #include "Graphics/skGraphics.h"
 #include "Utils/skDisableWarnings.h"
 
@@ -161,6 +162,158 @@ TEST_CASE("SK_OPACITY")
     skDeleteContext(ctx);
 }
 
+TEST_CASE("SK_BATCH_DRAWS")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+
+    // off unless asked for, so hosts that present without skFlush lose nothing
+    AssertEqualI(SK_BATCH_DRAWS, 0);
+    AssertEqualF(SK_BATCH_DRAWS, 0.f);
+
+    skSetContext1i(SK_BATCH_DRAWS, 1);
+    AssertEqualI(SK_BATCH_DRAWS, 1);
+
+    skSetContext1i(SK_BATCH_DRAWS, 0);
+    AssertEqualI(SK_BATCH_DRAWS, 0);
+
+    skSetContext1f(SK_BATCH_DRAWS, 3.f);
+    AssertEqualI(SK_BATCH_DRAWS, 1);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SK_REORDER_DRAWS")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+
+    AssertEqualI(SK_REORDER_DRAWS, 0);
+    AssertEqualF(SK_REORDER_DRAWS, 0.f);
+
+    skSetContext1i(SK_REORDER_DRAWS, 1);
+    AssertEqualI(SK_REORDER_DRAWS, 1);
+
+    skSetContext1f(SK_REORDER_DRAWS, 0.f);
+    AssertEqualI(SK_REORDER_DRAWS, 0);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SK_FLATTEN_TOLERANCE")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+
+    AssertEqualF(SK_FLATTEN_TOLERANCE, 0.f);
+
+    skSetContext1f(SK_FLATTEN_TOLERANCE, 0.25f);
+    AssertEqualF(SK_FLATTEN_TOLERANCE, 0.25f);
+
+    skSetContext1i(SK_FLATTEN_TOLERANCE, 2);
+    AssertEqualI(SK_FLATTEN_TOLERANCE, 2);
+
+    skSetContext1f(SK_FLATTEN_TOLERANCE, -1.f);
+    AssertEqualF(SK_FLATTEN_TOLERANCE, 0.f);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SK_STATE_CALLS")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+
+    // without a renderer there is nothing to count
+    AssertEqualI(SK_STATE_CALLS, 0);
+    AssertEqualI(SK_STATE_CALLS_SKIPPED, 0);
+
+    skSetContext1i(SK_STATE_CALLS, 10);
+    AssertEqualI(SK_STATE_CALLS, 0);
+    AssertEqualF(SK_STATE_CALLS_SKIPPED, 0.f);
+
+    // and nothing to forget
+    skInvalidateState();
+    AssertEqualI(SK_STATE_CALLS, 0);
+    skDeleteContext(ctx);
+
+    // nor is there any device state in software
+    ctx = skNewBackEndContext(SK_BE_Software);
+    skInvalidateStateEx(ctx);
+    AssertEqualI(SK_STATE_CALLS, 0);
+    AssertEqualI(SK_STATE_CALLS_SKIPPED, 0);
+    skDeleteContext(ctx);
+}
+
+struct TestDraw
+{
+    SKint32         state;
+    skBoundingBox2D bounds;
+    SKint32         next;
+};
+
+bool SameDraw(const TestDraw& a, const TestDraw& b)
+{
+    return a.state == b.state;
+}
+
+void PushDraw(skArray<TestDraw>& queue, SKint32 state, skScalar x1, skScalar y1, skScalar x2, skScalar y2)
+{
+    TestDraw draw;
+    draw.state = state;
+    draw.bounds.clear();
+    draw.bounds.compare(x1, y1);
+    draw.bounds.compare(x2, y2);
+    draw.next = -1;
+    queue.push_back(draw);
+}
+
+TEST_CASE("SortBatches")
+{
+    skArray<TestDraw>    queue;
+    skArray<SKbatchList> batches;
+
+    // 0 and 2 share a state, 1 sits on top of 0 in between
+    PushDraw(queue, 0, 0, 0, 10, 10);
+    PushDraw(queue, 1, 5, 5, 15, 15);
+    PushDraw(queue, 0, 8, 8, 12, 12);
+
+    skSortBatches(queue, batches, 16, SameDraw);
+
+    // so 2 cannot move under 1, and the order holds
+    EXPECT_EQ(3, batches.size());
+    EXPECT_EQ(0, batches[0].head);
+    EXPECT_EQ(1, batches[1].head);
+    EXPECT_EQ(2, batches[2].head);
+
+    // moved clear of 1, it joins 0
+    queue.resizeFast(0);
+    PushDraw(queue, 0, 0, 0, 10, 10);
+    PushDraw(queue, 1, 5, 5, 15, 15);
+    PushDraw(queue, 0, 20, 20, 30, 30);
+
+    skSortBatches(queue, batches, 16, SameDraw);
+
+    EXPECT_EQ(2, batches.size());
+    EXPECT_EQ(0, batches[0].head);
+    EXPECT_EQ(2, batches[0].tail);
+    EXPECT_EQ(2, queue[0].next);
+    EXPECT_EQ(-1, queue[2].next);
+    EXPECT_EQ(1, batches[1].head);
+    EXPECT_TRUE(batches[0].bounds.x2 == 30 && batches[0].bounds.y2 == 30);
+
+    // but only neighbours merge without a look back
+    skSortBatches(queue, batches, 1, SameDraw);
+    EXPECT_EQ(3, batches.size());
+
+    // and neighbours with the same state always do
+    queue.resizeFast(0);
+    PushDraw(queue, 3, 0, 0, 10, 10);
+    PushDraw(queue, 3, 0, 0, 10, 10);
+    PushDraw(queue, 3, 40, 40, 50, 50);
+
+    skSortBatches(queue, batches, 1, SameDraw);
+    EXPECT_EQ(1, batches.size());
+    EXPECT_EQ(0, batches[0].head);
+    EXPECT_EQ(2, batches[0].tail);
+}
+
 TEST_CASE("GetWorkingPaint")
 {
     // Test working paint creation / selection / deletion
@@ -252,6 +405,44 @@ TEST_CASE("PaintDefaults")
     skSetPaint1i(SK_AUTO_CLEAR, 1000);
     AssertPaintEqualI(SK_AUTO_CLEAR, 1);
 
+    AssertPaintEqualI(SK_FILL_RULE, SK_NON_ZERO);
+    skSetPaint1i(SK_FILL_RULE, SK_EVEN_ODD);
+    AssertPaintEqualI(SK_FILL_RULE, SK_EVEN_ODD);
+    skSetPaint1i(SK_FILL_RULE, -10000);
+    AssertPaintEqualI(SK_FILL_RULE, SK_NON_ZERO);
+    skSetPaint1i(SK_FILL_RULE, 10000);
+    AssertPaintEqualI(SK_FILL_RULE, SK_EVEN_ODD);
+
+    AssertPaintEqualI(SK_FILL_MODE, SK_FILL_TESSELLATE);
+    skSetPaint1i(SK_FILL_MODE, SK_FILL_STENCIL);
+    AssertPaintEqualI(SK_FILL_MODE, SK_FILL_STENCIL);
+    skSetPaint1i(SK_FILL_MODE, -10000);
+    AssertPaintEqualI(SK_FILL_MODE, SK_FILL_TESSELLATE);
+    skSetPaint1i(SK_FILL_MODE, 10000);
+    AssertPaintEqualI(SK_FILL_MODE, SK_FILL_STENCIL);
+
+    AssertPaintEqualI(SK_PEN_JOIN, SK_JOIN_MITER);
+    skSetPaint1i(SK_PEN_JOIN, SK_JOIN_ROUND);
+    AssertPaintEqualI(SK_PEN_JOIN, SK_JOIN_ROUND);
+    skSetPaint1i(SK_PEN_JOIN, -10000);
+    AssertPaintEqualI(SK_PEN_JOIN, SK_JOIN_MITER);
+    skSetPaint1i(SK_PEN_JOIN, 10000);
+    AssertPaintEqualI(SK_PEN_JOIN, SK_JOIN_BEVEL);
+
+    AssertPaintEqualI(SK_PEN_CAP, SK_CAP_BUTT);
+    skSetPaint1i(SK_PEN_CAP, SK_CAP_ROUND);
+    AssertPaintEqualI(SK_PEN_CAP, SK_CAP_ROUND);
+    skSetPaint1i(SK_PEN_CAP, -10000);
+    AssertPaintEqualI(SK_PEN_CAP, SK_CAP_BUTT);
+    skSetPaint1i(SK_PEN_CAP, 10000);
+    AssertPaintEqualI(SK_PEN_CAP, SK_CAP_SQUARE);
+
+    AssertPaintEqualF(SK_DASH_PHASE, 0);
+    skSetPaint1f(SK_DASH_PHASE, 2.5f);
+    AssertPaintEqualF(SK_DASH_PHASE, 2.5f);
+    skSetPaint1f(SK_DASH_PHASE, -3);
+    AssertPaintEqualF(SK_DASH_PHASE, -3);
+
     AssertPaintEqualUI(SK_BRUSH_COLOR, CS_Grey10);
     skSetPaint1ui(SK_BRUSH_COLOR, CS_Grey05);
     AssertPaintEqualUI(SK_BRUSH_COLOR, CS_Grey05);
@@ -333,6 +524,68 @@ TEST_CASE("GetWorkingPath")
     skDeleteContext(ctx);
 }
 
+TEST_CASE("PathCurves")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+    SKaabbf   bb;
+
+    // the middle of the curve is sampled, and is the peak
+    skClearPath();
+    skMoveTo(0, 0);
+    skQuadTo(10, 20, 20, 0);
+    skGetPathBoundingBox(&bb);
+    EXPECT_TRUE(fabs(bb.x2 - 20) < 1e-3f);
+    EXPECT_TRUE(fabs(bb.y2 - 10) < 1e-3f);
+
+    skClearPath();
+    skMoveTo(0, 0);
+    skBezierTo(0, 20, 20, 20, 20, 0);
+    skGetPathBoundingBox(&bb);
+    EXPECT_TRUE(fabs(bb.x2 - 20) < 1e-3f);
+    EXPECT_TRUE(fabs(bb.y2 - 15) < 1e-3f);
+
+    // within a tenth of a pixel of the peak
+    skSetContext1f(SK_FLATTEN_TOLERANCE, 0.1f);
+    skClearPath();
+    skMoveTo(0, 0);
+    skQuadTo(100, 200, 200, 0);
+    skGetPathBoundingBox(&bb);
+    EXPECT_TRUE(fabs(bb.y2 - 100) < 0.1f);
+
+    skClearPath();
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("PathAppend")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+    SKaabbf   bb;
+
+    const SKscalar line[6] = {0, 0, 10, 20, 30, -5};
+
+    skClearPath();
+    skPathAppend(line, 3, SK_APPEND_MOVE);
+    skGetPathBoundingBox(&bb);
+    EXPECT_TRUE(fabs(bb.x1 - 0) < 1e-3f);
+    EXPECT_TRUE(fabs(bb.y1 + 5) < 1e-3f);
+    EXPECT_TRUE(fabs(bb.x2 - 30) < 1e-3f);
+    EXPECT_TRUE(fabs(bb.y2 - 20) < 1e-3f);
+
+    // the scale and bias apply just as they do to lineTo
+    skClearPath();
+    skPathSetScale(2, 2);
+    skPathSetBias(1, 1);
+    skPathAppend(line, 3, SK_APPEND_MOVE);
+    skGetPathBoundingBox(&bb);
+    EXPECT_TRUE(fabs(bb.x2 - 61) < 1e-3f);
+    EXPECT_TRUE(fabs(bb.y1 + 9) < 1e-3f);
+
+    skPathSetScale(1, 1);
+    skPathSetBias(0, 0);
+    skClearPath();
+    skDeleteContext(ctx);
+}
+
 /*
 SK_API void skSetImage1i(SKimage image, SKimageOptionEnum en, SKint32 v);
 SK_API void skGetImage1i(SKimage image, SKimageOptionEnum en, SKint32* v);
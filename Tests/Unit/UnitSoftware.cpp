@@ -0,0 +1,1040 @@
+/*
+-------------------------------------------------------------------------------
+    Copyright (c) Charles Carley.
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+-------------------------------------------------------------------------------
+*/
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include "Catch2.h"
+#include "Graphics/skGraphics.h"
+#include "Utils/skDisableWarnings.h"
+
+void AssertImageSize(SKimage ima, SKint32 w, SKint32 h)
+{
+    SKint32 prop = SK_NO_STATUS;
+    skGetImage1i(ima, SK_IMAGE_WIDTH, &prop);
+    EXPECT_EQ(w, prop);
+
+    prop = SK_NO_STATUS;
+    skGetImage1i(ima, SK_IMAGE_HEIGHT, &prop);
+    EXPECT_EQ(h, prop);
+}
+
+// A 48x48 software context in a y down projection that
+// clears to opaque black and paints opaque white.
+SKcontext NewContext48(void)
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    skSetContext2i(SK_CONTEXT_SIZE, 48, 48);
+    skProjectContext(SK_STANDARD);
+    skClearColor1i(0x000000FF);
+    skColor1ui(0xFFFFFFFF);
+    return ctx;
+}
+
+// Returns the RGBA pixel at (x, y) measured from the top left of
+// a target that is height pixels tall. skReadPixels counts rows
+// from the bottom, like glReadPixels, so the row is flipped here.
+SKuint32 ReadPixel(SKint32 x, SKint32 y, SKint32 height = 48)
+{
+    SKubyte px[4] = {0, 0, 0, 0};
+    skReadPixels(x, height - 1 - y, 1, 1, px);
+    return (SKuint32)px[0] << 24 | (SKuint32)px[1] << 16 | (SKuint32)px[2] << 8 | px[3];
+}
+
+TEST_CASE("SoftwareContextCreate")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    EXPECT_NE(ctx, nullptr);
+    EXPECT_EQ(ctx, skGetCurrentContext());
+
+    skSetContext2i(SK_CONTEXT_SIZE, 64, 32);
+    skProjectContext(SK_STANDARD);
+
+    SKimage target = skGetContextImage();
+    EXPECT_NE(target, nullptr);
+    AssertImageSize(target, 64, 32);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareContextResize")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+
+    skSetContext2i(SK_CONTEXT_SIZE, 16, 16);
+    AssertImageSize(skGetContextImage(), 16, 16);
+
+    skSetContext2i(SK_CONTEXT_SIZE, 48, 24);
+    AssertImageSize(skGetContextImage(), 48, 24);
+
+    // the target belongs to the renderer
+    skDeleteImage(skGetContextImage());
+    AssertImageSize(skGetContextImage(), 48, 24);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareNoTarget")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_None);
+    EXPECT_EQ(skGetContextImage(), nullptr);
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareDraw")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+
+    skSetContext2i(SK_CONTEXT_SIZE, 64, 64);
+    skProjectContext(SK_STANDARD);
+    skClearColor4f(0, 0, 0, 1);
+    skClearContext();
+
+    skColor4f(1, 0, 0, 1);
+    skRect(8, 8, 32, 32);
+    skFill();
+
+    skSetPaint1f(SK_PEN_WIDTH, 3);
+    skEllipse(32, 32, 20, 20);
+    skStroke();
+
+    SKfont font = skNewFont(SK_FONT_DEFAULT, 12, 72);
+    EXPECT_NE(font, nullptr);
+    skSelectFont(font);
+    skDisplayString(font, "Software", 8, 0, 20);
+
+    AssertImageSize(skGetContextImage(), 64, 64);
+
+    // inside the rectangle and on the ring
+    EXPECT_EQ(0xFF0000FF, ReadPixel(16, 16, 64));
+    EXPECT_EQ(0xFF0000FF, ReadPixel(51, 42, 64));
+
+    // and outside both or in the middle of the ring
+    EXPECT_EQ(0x000000FF, ReadPixel(4, 4, 64));
+    EXPECT_EQ(0x000000FF, ReadPixel(56, 16, 64));
+    EXPECT_EQ(0x000000FF, ReadPixel(42, 42, 64));
+
+    skDeleteFont(font);
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SK_WORKER_THREADS")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+
+    SKint32 prop = SK_NO_STATUS;
+    skGetContext1i(SK_WORKER_THREADS, &prop);
+    EXPECT_EQ(SK_DEFAULT_WORKER_THREADS, prop);
+
+    skSetContext1i(SK_WORKER_THREADS, 4);
+    skGetContext1i(SK_WORKER_THREADS, &prop);
+    EXPECT_EQ(4, prop);
+
+    skSetContext1i(SK_WORKER_THREADS, -1);
+    skGetContext1i(SK_WORKER_THREADS, &prop);
+    EXPECT_EQ(1, prop);
+
+    skSetContext1i(SK_WORKER_THREADS, 55555555);
+    skGetContext1i(SK_WORKER_THREADS, &prop);
+    EXPECT_EQ(SK_MAX_WORKER_THREADS, prop);
+
+    skDeleteContext(ctx);
+}
+
+void DrawSoftwareScene(SKint32 threads, SKint32 antiAlias, const char* path)
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    skSetContext1i(SK_WORKER_THREADS, threads);
+    skSetContext1i(SK_ANTI_ALIAS, antiAlias);
+    skSetContext2i(SK_CONTEXT_SIZE, 300, 200);
+    skProjectContext(SK_STANDARD);
+    skClearColor1i(CS_Grey02);
+    skClearContext();
+
+    for (SKint32 i = 0; i < 40; ++i)
+    {
+        skColor4f(SKscalar(i % 3) / 2.f, SKscalar(i % 5) / 4.f, .5f, .5f);
+        skEllipse(SKscalar(i * 7), SKscalar(i * 5), 40, 25);
+        skFill();
+    }
+
+    skSetPaint1f(SK_PEN_WIDTH, 3);
+    skColor4f(1, 1, 1, 1);
+    skRect(20, 20, 260, 160);
+    skStroke();
+
+    SKfont font = skNewFont(SK_FONT_DEFAULT, 24, 72);
+    skDisplayString(font, "Tiles", 5, 100, 100);
+
+    skImageSave(skGetContextImage(), path);
+    skDeleteFont(font);
+    skDeleteContext(ctx);
+}
+
+bool FilesEqual(const char* a, const char* b)
+{
+    FILE* fa = fopen(a, "rb");
+    FILE* fb = fopen(b, "rb");
+
+    bool result = fa && fb;
+    while (result)
+    {
+        const int ca = fgetc(fa);
+        const int cb = fgetc(fb);
+        if (ca != cb)
+            result = false;
+        else if (ca == EOF)
+            break;
+    }
+
+    if (fa)
+        fclose(fa);
+    if (fb)
+        fclose(fb);
+    return result;
+}
+
+// Returns name inside the system temporary directory, so
+// that saved images do not land in the working directory.
+std::string TempPath(const char* name)
+{
+#ifdef _WIN32
+    const char* dir = getenv("TEMP");
+    const char  sep = '\\';
+#else
+    const char* dir = getenv("TMPDIR");
+    const char  sep = '/';
+#endif
+    std::string path = dir && *dir ? dir : (sep == '/' ? "/tmp" : ".");
+    if (path.back() != sep)
+        path.push_back(sep);
+    return path.append(name);
+}
+
+// Loads path back into a new image and checks its size, which
+// fails when the file was never written or cannot be read.
+void AssertImageFile(const std::string& path, SKint32 w, SKint32 h)
+{
+    SKcontext current = skGetCurrentContext();
+    SKcontext ctx     = skNewBackEndContext(SK_BE_None);
+
+    SKimage ima = skImageLoad(path.c_str());
+    EXPECT_NE(ima, nullptr);
+    AssertImageSize(ima, w, h);
+
+    skDeleteImage(ima);
+    skDeleteContext(ctx);
+    skSetCurrentContext(current);
+}
+
+TEST_CASE("SoftwareTilesMatchImmediate")
+{
+    const std::string immediate = TempPath("SoftwareImmediate.png");
+    const std::string tiled     = TempPath("SoftwareTiled.png");
+
+    DrawSoftwareScene(1, 0, immediate.c_str());
+    DrawSoftwareScene(4, 0, tiled.c_str());
+    AssertImageFile(immediate, 300, 200);
+    AssertImageFile(tiled, 300, 200);
+
+    EXPECT_TRUE(FilesEqual(immediate.c_str(), tiled.c_str()));
+
+    remove(immediate.c_str());
+    remove(tiled.c_str());
+}
+
+TEST_CASE("SK_ANTI_ALIAS")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+
+    SKint32 prop = SK_NO_STATUS;
+    skGetContext1i(SK_ANTI_ALIAS, &prop);
+    EXPECT_EQ(0, prop);
+
+    skSetContext1i(SK_ANTI_ALIAS, 1);
+    skGetContext1i(SK_ANTI_ALIAS, &prop);
+    EXPECT_EQ(1, prop);
+
+    skSetContext1i(SK_ANTI_ALIAS, 0);
+    skGetContext1i(SK_ANTI_ALIAS, &prop);
+    EXPECT_EQ(0, prop);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareReadWithoutFlush")
+{
+    SKcontext ctx = NewContext48();
+    skSetContext1i(SK_WORKER_THREADS, 4);
+    skSetContext1i(SK_BATCH_DRAWS, 1);
+
+    // binned and batched draws are drawn by the read, not by skFlush
+    skClearContext();
+    skRect(4, 4, 16, 8);
+    skFill();
+    skRect(4, 20, 16, 8);
+    skFill();
+
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(8, 6));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(8, 22));
+    EXPECT_EQ(0x000000FF, ReadPixel(8, 16));
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareAntiAliasTilesMatchImmediate")
+{
+    const std::string aliased   = TempPath("SoftwareAliased.png");
+    const std::string immediate = TempPath("SoftwareImmediateAA.png");
+    const std::string tiled     = TempPath("SoftwareTiledAA.png");
+
+    DrawSoftwareScene(1, 0, aliased.c_str());
+    DrawSoftwareScene(1, 1, immediate.c_str());
+    DrawSoftwareScene(4, 1, tiled.c_str());
+
+    // all three exist, so a difference is a real difference
+    AssertImageFile(aliased, 300, 200);
+    AssertImageFile(immediate, 300, 200);
+    AssertImageFile(tiled, 300, 200);
+
+    EXPECT_TRUE(FilesEqual(immediate.c_str(), tiled.c_str()));
+    EXPECT_FALSE(FilesEqual(aliased.c_str(), immediate.c_str()));
+
+    remove(aliased.c_str());
+    remove(immediate.c_str());
+    remove(tiled.c_str());
+}
+
+TEST_CASE("SoftwareRenderTarget")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    skSetContext2i(SK_CONTEXT_SIZE, 32, 16);
+    skProjectContext(SK_STANDARD);
+
+    SKimage target = skNewRenderTarget(32, 16, SK_RGBA);
+    EXPECT_NE(target, nullptr);
+    AssertImageSize(target, 32, 16);
+
+    skClearColor4f(0, 0, 1, 1);
+    skClearContext();
+
+    skBindRenderTarget(target);
+    skClearColor4f(1, 0, 0, 1);
+    skClearContext();
+
+    // the upper left quarter in a y down projection
+    skColor4f(0, 1, 0, 1);
+    skRect(0, 0, 16, 8);
+    skFill();
+
+    SKubyte pixels[32 * 16 * 4];
+    skReadPixels(0, 0, 32, 16, pixels);
+
+    // rows come back bottom up
+    const SKubyte* lowerLeft = pixels;
+    const SKubyte* upperLeft = pixels + 15 * 32 * 4;
+    EXPECT_EQ(255, lowerLeft[0]);
+    EXPECT_EQ(0, lowerLeft[1]);
+    EXPECT_EQ(0, upperLeft[0]);
+    EXPECT_EQ(255, upperLeft[1]);
+    EXPECT_EQ(255, upperLeft[3]);
+
+    // the context image is untouched
+    skBindRenderTarget(nullptr);
+    skReadPixels(0, 0, 1, 1, pixels);
+    EXPECT_EQ(0, pixels[0]);
+    EXPECT_EQ(255, pixels[2]);
+
+    // a target saves like any other image
+    const std::string saved = TempPath("SoftwareRenderTarget.png");
+    skImageSave(target, saved.c_str());
+    AssertImageFile(saved, 32, 16);
+    remove(saved.c_str());
+
+    // deleting a bound target restores the context image
+    skBindRenderTarget(target);
+    skDeleteImage(target);
+    skReadPixels(0, 0, 1, 1, pixels);
+    EXPECT_EQ(255, pixels[2]);
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareRenderTargetView")
+{
+    SKcontext ctx = NewContext48();
+
+    // wider and shorter than the context
+    SKimage target = skNewRenderTarget(64, 16, SK_RGBA);
+    EXPECT_NE(target, nullptr);
+
+    skBindRenderTarget(target);
+    skClearColor1i(0xFF0000FF);
+    skClearContext();
+
+    // the right quarter lies past the context's width
+    skColor1ui(0x00FF00FF);
+    skRect(48, 0, 16, 8);
+    skFill();
+
+    EXPECT_EQ(0x00FF00FF, ReadPixel(56, 4, 16));
+    EXPECT_EQ(0xFF0000FF, ReadPixel(56, 12, 16));
+    EXPECT_EQ(0xFF0000FF, ReadPixel(40, 4, 16));
+
+    // unbinding puts the context's view back
+    skBindRenderTarget(nullptr);
+    skClearColor1i(0x000000FF);
+    skClearContext();
+    skColor1ui(0xFFFFFFFF);
+    skRect(0, 0, 24, 24);
+    skFill();
+
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(4, 4));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(20, 20));
+    EXPECT_EQ(0x000000FF, ReadPixel(28, 4));
+    EXPECT_EQ(0x000000FF, ReadPixel(4, 28));
+
+    skDeleteImage(target);
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("RenderTargetFormat")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    EXPECT_EQ(skNewRenderTarget(8, 8, SK_ALPHA), nullptr);
+    skDeleteContext(ctx);
+
+    ctx = skNewBackEndContext(SK_BE_None);
+    EXPECT_EQ(skNewRenderTarget(8, 8, SK_RGBA), nullptr);
+    skDeleteContext(ctx);
+}
+
+void DrawListScene(SKfont font)
+{
+    skColor4f(1, .5f, 0, 1);
+    skRect(10, 10, 50, 30);
+    skFill();
+
+    skSetPaint1f(SK_PEN_WIDTH, 2);
+    skColor4f(0, .5f, 1, .75f);
+    skEllipse(60, 40, 30, 20);
+    skStroke();
+
+    skColor4f(1, 1, 1, 1);
+    skDisplayString(font, "List", 4, 20, 60);
+}
+
+TEST_CASE("SoftwareDisplayList")
+{
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    skSetContext2i(SK_CONTEXT_SIZE, 120, 90);
+    skProjectContext(SK_STANDARD);
+    skClearColor1i(CS_Grey02);
+
+    SKfont font = skNewFont(SK_FONT_DEFAULT, 12, 72);
+
+    const SKint32 size = 120 * 90 * 4;
+
+    SKubyte* direct = new SKubyte[size];
+    SKubyte* pixels = new SKubyte[size];
+
+    skClearContext();
+    DrawListScene(font);
+    skReadPixels(0, 0, 120, 90, direct);
+
+    skBeginList();
+    DrawListScene(font);
+    SKlist list = skEndList();
+    EXPECT_NE(list, nullptr);
+
+    // recording does not draw
+    skClearContext();
+    skReadPixels(0, 0, 120, 90, pixels);
+    EXPECT_NE(0, memcmp(direct, pixels, size));
+
+    // and the list does not depend on the working path or paint
+    skClearPath();
+    skColor4f(0, 0, 0, 0);
+
+    skCallList(list);
+    skReadPixels(0, 0, 120, 90, pixels);
+    EXPECT_EQ(0, memcmp(direct, pixels, size));
+
+    // calling a list while recording copies it
+    skBeginList();
+    skCallList(list);
+    SKlist nested = skEndList();
+    skDeleteList(list);
+
+    skClearContext();
+    skCallList(nested);
+    skReadPixels(0, 0, 120, 90, pixels);
+    EXPECT_EQ(0, memcmp(direct, pixels, size));
+
+    EXPECT_EQ(skEndList(), nullptr);
+
+    skDeleteList(nested);
+    skDeleteFont(font);
+    skDeleteContext(ctx);
+    delete[] direct;
+    delete[] pixels;
+}
+
+bool RowsClear(SKint32 y1, SKint32 y2)
+{
+    for (SKint32 y = y1; y < y2; ++y)
+    {
+        for (SKint32 x = 0; x < 48; ++x)
+        {
+            if (ReadPixel(x, y) != 0x000000FF)
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE("SoftwareDisplayListRelease")
+{
+    SKcontext ctx = NewContext48();
+
+    // a green image to draw with
+    SKimage pattern = skNewRenderTarget(8, 8, SK_RGBA);
+    skBindRenderTarget(pattern);
+    skClearColor1i(0x00FF00FF);
+    skClearContext();
+    skBindRenderTarget(nullptr);
+    skClearColor1i(0x000000FF);
+
+    SKfont font = skNewFont(SK_FONT_DEFAULT, 12, 72);
+
+    skBeginList();
+    skRect(0, 0, 24, 12);
+    skFill();
+    skSelectImage(pattern);
+    skRect(24, 0, 24, 12);
+    skFill();
+    skSelectImage(nullptr);
+    skDisplayString(font, "List", 4, 4, 40);
+    SKlist list = skEndList();
+
+    skClearContext();
+    skCallList(list);
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(4, 4));
+    EXPECT_EQ(0x00FF00FF, ReadPixel(36, 4));
+    EXPECT_FALSE(RowsClear(24, 48));
+
+    // deleting what a list draws with drops those items
+    skDeleteImage(pattern);
+    skDeleteFont(font);
+
+    skClearContext();
+    skCallList(list);
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(4, 4));
+    EXPECT_EQ(0x000000FF, ReadPixel(36, 4));
+    EXPECT_TRUE(RowsClear(24, 48));
+
+    // and the context frees any list that is still alive
+    skBeginList();
+    skRect(0, 0, 8, 8);
+    skFill();
+    skEndList();
+
+    skDeleteList(list);
+    skDeleteContext(ctx);
+}
+
+void AssertInstances(SKuint32 first, SKuint32 second, SKuint32 third)
+{
+    // the first is moved to (4, 4)
+    EXPECT_EQ(first, ReadPixel(8, 6));
+    EXPECT_EQ(0x000000FF, ReadPixel(8, 10));
+
+    // the second is twice as wide at (20, 8)
+    EXPECT_EQ(second, ReadPixel(21, 10));
+    EXPECT_EQ(second, ReadPixel(34, 10));
+    EXPECT_EQ(0x000000FF, ReadPixel(38, 10));
+
+    // and the third is turned a quarter to stand upright at (36, 24)
+    EXPECT_EQ(third, ReadPixel(38, 30));
+    EXPECT_EQ(0x000000FF, ReadPixel(42, 26));
+}
+
+TEST_CASE("SoftwareFillInstanced")
+{
+    SKcontext ctx = NewContext48();
+
+    const SKscalar transforms[] = {
+        1, 0, 4, 0, 1, 4,
+        2, 0, 20, 0, 1, 8,
+        0, -1, 40, 1, 0, 24,
+    };
+    const SKcolori colors[] = {0xFF0000FF, 0x00FF00FF, 0x0000FFFF};
+
+    SKpath marker = skNewPath();
+    skSelectPath(marker);
+    skMoveTo(0, 0);
+    skLineTo(8, 0);
+    skLineTo(8, 4);
+    skLineTo(0, 4);
+    skClosePath();
+    skSelectPath(nullptr);
+
+    // the software renderer has no instanced draw, so this is the
+    // same per instance fallback the OpenGL renderer takes without
+    // hardware instancing
+    skClearContext();
+    skFillInstanced(marker, transforms, colors, 3);
+    AssertInstances(0xFF0000FF, 0x00FF00FF, 0x0000FFFF);
+
+    // without colors every instance takes the paint color
+    skClearContext();
+    skFillInstanced(marker, transforms, nullptr, 3);
+    AssertInstances(0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF);
+
+    // and the paint color is left as it was
+    skClearContext();
+    skFillInstanced(marker, transforms, colors, 1);
+    skFillInstanced(marker, transforms + 6, nullptr, 2);
+    AssertInstances(0xFF0000FF, 0xFFFFFFFF, 0xFFFFFFFF);
+
+    // recorded lists replay the same instances
+    skBeginList();
+    skFillInstanced(marker, transforms, colors, 3);
+    SKlist list = skEndList();
+
+    skClearContext();
+    skCallList(list);
+    AssertInstances(0xFF0000FF, 0x00FF00FF, 0x0000FFFF);
+
+    skDeleteList(list);
+    skDeletePath(marker);
+    skDeleteContext(ctx);
+}
+
+SKuint32 StarPixel(SKint32 rule, SKint32 x, SKint32 y)
+{
+    skSetPaint1i(SK_FILL_RULE, rule);
+    skClearContext();
+    skClearPath();
+    skStar(0, 0, 48, 48, 5, 2);
+    skFill();
+    return ReadPixel(x, y);
+}
+
+TEST_CASE("SK_FILL_RULE")
+{
+    SKcontext ctx = NewContext48();
+
+    // the middle of a five point star is wound twice
+    EXPECT_EQ(0xFFFFFFFF, StarPixel(SK_NON_ZERO, 24, 28));
+    EXPECT_EQ(0x000000FF, StarPixel(SK_EVEN_ODD, 24, 28));
+
+    // the top point is wound once, and there is no point at the bottom
+    EXPECT_EQ(0xFFFFFFFF, StarPixel(SK_EVEN_ODD, 24, 8));
+    EXPECT_EQ(0x000000FF, StarPixel(SK_NON_ZERO, 24, 39));
+
+    skSetContext1i(SK_ANTI_ALIAS, 1);
+    EXPECT_EQ(0xFFFFFFFF, StarPixel(SK_NON_ZERO, 24, 28));
+    EXPECT_EQ(0x000000FF, StarPixel(SK_EVEN_ODD, 24, 28));
+    EXPECT_EQ(0xFFFFFFFF, StarPixel(SK_EVEN_ODD, 24, 8));
+    EXPECT_EQ(0x000000FF, StarPixel(SK_NON_ZERO, 24, 39));
+
+    skDeleteContext(ctx);
+}
+
+SKuint32 EllipseEdge(SKscalar tolerance, SKint32 x, SKint32 y)
+{
+    skSetContext1f(SK_FLATTEN_TOLERANCE, tolerance);
+    skClearContext();
+    skClearPath();
+    skEllipse(0, 0, 48, 24);
+    skFill();
+    return ReadPixel(x, y);
+}
+
+TEST_CASE("SoftwareFlattenTolerance")
+{
+    SKcontext ctx = NewContext48();
+
+    // a fine tolerance follows the ellipse out to its edge
+    EXPECT_EQ(0xFFFFFFFF, EllipseEdge(0, 4, 12));
+    EXPECT_EQ(0xFFFFFFFF, EllipseEdge(0.25f, 4, 12));
+
+    // and one wider than the radius leaves a triangle
+    EXPECT_EQ(0x000000FF, EllipseEdge(100, 4, 12));
+
+    // the ellipse only covers the upper half
+    EXPECT_EQ(0x000000FF, EllipseEdge(0.25f, 24, 36));
+
+    skDeleteContext(ctx);
+}
+
+SKuint32 StrokePixel(SKint32 join, SKint32 cap, SKint32 x, SKint32 y)
+{
+    skSetPaint1i(SK_PEN_JOIN, join);
+    skSetPaint1i(SK_PEN_CAP, cap);
+    skClearContext();
+    skClearPath();
+    skMoveTo(12, 36);
+    skLineTo(12, 12);
+    skLineTo(36, 12);
+    skStroke();
+    return ReadPixel(x, y);
+}
+
+TEST_CASE("SoftwareStrokeJoinsAndCaps")
+{
+    SKcontext ctx = NewContext48();
+    skSetPaint1f(SK_PEN_WIDTH, 8);
+
+    // the outer corner of the turn at (12, 12)
+    EXPECT_EQ(0xFFFFFFFF, StrokePixel(SK_JOIN_MITER, SK_CAP_BUTT, 8, 8));
+    EXPECT_EQ(0x000000FF, StrokePixel(SK_JOIN_BEVEL, SK_CAP_BUTT, 8, 8));
+    EXPECT_EQ(0x000000FF, StrokePixel(SK_JOIN_ROUND, SK_CAP_BUTT, 8, 8));
+
+    // past the end at (36, 12)
+    EXPECT_EQ(0x000000FF, StrokePixel(SK_JOIN_MITER, SK_CAP_BUTT, 38, 12));
+    EXPECT_EQ(0xFFFFFFFF, StrokePixel(SK_JOIN_MITER, SK_CAP_SQUARE, 38, 12));
+    EXPECT_EQ(0xFFFFFFFF, StrokePixel(SK_JOIN_MITER, SK_CAP_ROUND, 38, 12));
+    EXPECT_EQ(0x000000FF, StrokePixel(SK_JOIN_MITER, SK_CAP_ROUND, 39, 9));
+
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareStrokeJoinAlpha")
+{
+    SKcontext ctx = NewContext48();
+    skSetPaint1f(SK_PEN_WIDTH, 8);
+    skColor1ui(0xFFFFFF80);
+
+    for (SKint32 antiAlias = 0; antiAlias < 2; ++antiAlias)
+    {
+        skSetContext1i(SK_ANTI_ALIAS, antiAlias);
+
+        // one blend of the colour over the black
+        skClearContext();
+        skClearPath();
+        skRect(0, 0, 48, 48);
+        skFill();
+        const SKuint32 once = ReadPixel(24, 24);
+        EXPECT_NE(0x000000FF, once);
+
+        // the segments and the miter meet at the corner
+        // and in the middle of it, none of them twice
+        EXPECT_EQ(once, StrokePixel(SK_JOIN_MITER, SK_CAP_BUTT, 12, 12));
+        EXPECT_EQ(once, StrokePixel(SK_JOIN_MITER, SK_CAP_BUTT, 9, 9));
+        EXPECT_EQ(once, StrokePixel(SK_JOIN_MITER, SK_CAP_BUTT, 14, 14));
+        EXPECT_EQ(once, StrokePixel(SK_JOIN_ROUND, SK_CAP_BUTT, 12, 12));
+        EXPECT_EQ(once, StrokePixel(SK_JOIN_MITER, SK_CAP_BUTT, 12, 24));
+    }
+
+    skDeleteContext(ctx);
+}
+
+SKuint32 DashPixel(SKscalar phase, SKint32 x, SKint32 y)
+{
+    skSetPaint1f(SK_DASH_PHASE, phase);
+    skClearContext();
+    skClearPath();
+    skMoveTo(4, 24);
+    skLineTo(24, 24);
+    skLineTo(24, 44);
+    skStroke();
+    return ReadPixel(x, y);
+}
+
+TEST_CASE("SoftwareDashedStroke")
+{
+    SKcontext ctx = NewContext48();
+    skSetPaint1f(SK_PEN_WIDTH, 4);
+    skSetPaint1i(SK_PEN_STYLE, SK_PS_DASHED);
+
+    const SKscalar pattern[2] = {4, 4};
+    skSetPaintDashes(pattern, 2);
+
+    // on from 4 to 8, off from 8 to 12
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(0, 6, 24));
+    EXPECT_EQ(0x000000FF, DashPixel(0, 10, 24));
+
+    // moving the phase swaps them
+    EXPECT_EQ(0x000000FF, DashPixel(4, 6, 24));
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(4, 10, 24));
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(-4, 10, 24));
+
+    // and the pattern carries on round the corner at 20
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(0, 24, 30));
+    EXPECT_EQ(0x000000FF, DashPixel(0, 24, 34));
+
+    // an odd pattern repeats, {2, 6, 2} is {2, 6, 2, 2, 6, 2}
+    const SKscalar odd[3] = {2, 6, 2};
+    skSetPaintDashes(odd, 3);
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(0, 5, 24));
+    EXPECT_EQ(0x000000FF, DashPixel(0, 9, 24));
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(0, 17, 24));
+
+    // and no pattern is solid
+    skSetPaintDashes(nullptr, 0);
+    EXPECT_EQ(0xFFFFFFFF, DashPixel(0, 10, 24));
+
+    skDeleteContext(ctx);
+}
+
+SKuint32 DashModePixel(SKint32 lineType, SKint32 x, SKint32 y)
+{
+    skSetPaint1i(SK_LINE_TYPE, lineType);
+    skClearContext();
+    skStroke();
+    return ReadPixel(x, y);
+}
+
+TEST_CASE("SoftwareDashedListAndStrip")
+{
+    SKcontext ctx = NewContext48();
+    skSetPaint1f(SK_PEN_WIDTH, 4);
+    skSetPaint1i(SK_PEN_STYLE, SK_PS_DASHED);
+
+    const SKscalar pattern[2] = {4, 4};
+    skSetPaintDashes(pattern, 2);
+
+    // as a list this is two lines, 4 to 12 and 20 to 28,
+    // and as a strip one line from 4 to 28
+    skClearPath();
+    skMoveTo(4, 24);
+    skLineTo(12, 24);
+    skLineTo(20, 24);
+    skLineTo(28, 24);
+
+    // the same path alternates between the two, so
+    // the dashes of one cannot be handed to the other
+    for (int i = 0; i < 2; ++i)
+    {
+        EXPECT_EQ(0x000000FF, DashModePixel(SK_LINE_LIST, 14, 24));
+        EXPECT_EQ(0xFFFFFFFF, DashModePixel(SK_LINE_LIST, 22, 24));
+        EXPECT_EQ(0xFFFFFFFF, DashModePixel(SK_LINE_LOOP, 14, 24));
+        EXPECT_EQ(0x000000FF, DashModePixel(SK_LINE_LOOP, 18, 24));
+    }
+
+    skDeleteContext(ctx);
+}
+
+void Square(SKscalar x1, SKscalar y1, SKscalar x2, SKscalar y2)
+{
+    skMoveTo(x1, y1);
+    skLineTo(x2, y1);
+    skLineTo(x2, y2);
+    skLineTo(x1, y2);
+    skClosePath();
+}
+
+TEST_CASE("SoftwareSubpaths")
+{
+    SKcontext ctx = NewContext48();
+
+    // a hole that winds the other way is left open with either rule
+    skClearContext();
+    skClearPath();
+    Square(4, 4, 44, 44);
+    Square(16, 32, 32, 16);
+    skFill();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(8, 24));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 24));
+
+    // one that winds the same way only with SK_EVEN_ODD
+    skClearContext();
+    skClearPath();
+    Square(4, 4, 44, 44);
+    Square(16, 16, 32, 32);
+    skFill();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 24));
+
+    skSetPaint1i(SK_FILL_RULE, SK_EVEN_ODD);
+    skClearContext();
+    skFill();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(8, 24));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 24));
+
+    // strokes do not join one subpath to the next
+    skClearContext();
+    skClearPath();
+    skMoveTo(4, 8);
+    skLineTo(44, 8);
+    skMoveTo(4, 40);
+    skLineTo(44, 40);
+    skStroke();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 8));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 40));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 24));
+
+    skSetPaint1f(SK_PEN_WIDTH, 4);
+    skClearContext();
+    skStroke();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 9));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 24));
+
+    // the same outlines appended in bulk
+    const SKscalar outer[8] = {4, 4, 44, 4, 44, 44, 4, 44};
+    const SKscalar inner[8] = {16, 16, 32, 16, 32, 32, 16, 32};
+
+    skSetPaint1f(SK_PEN_WIDTH, 1);
+    skClearContext();
+    skClearPath();
+    skPathAppend(outer, 4, SK_APPEND_MOVE | SK_APPEND_CLOSE);
+    skPathAppend(inner, 4, SK_APPEND_MOVE | SK_APPEND_CLOSE);
+    skFill();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(8, 24));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 24));
+
+    // nothing is filled between three or more subpaths
+    skSetPaint1i(SK_FILL_RULE, SK_NON_ZERO);
+    skClearContext();
+    skClearPath();
+    Square(2, 2, 10, 10);
+    Square(38, 2, 46, 10);
+    Square(20, 38, 28, 46);
+    skFill();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(6, 6));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(42, 6));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 42));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 6));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 20));
+
+    skSetContext1i(SK_ANTI_ALIAS, 1);
+    skClearContext();
+    skFill();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 42));
+    EXPECT_EQ(0x000000FF, ReadPixel(24, 20));
+
+    skDeleteContext(ctx);
+}
+
+void SpikedRect(void)
+{
+    // a spike 3 units tall on top of the rectangle
+    const SKscalar pts[14] = {2, 20, 2, 12, 11, 12, 12, 9, 13, 12, 22, 12, 22, 20};
+
+    skClearContext();
+    skClearPath();
+    skPathAppend(pts, 7, SK_APPEND_MOVE | SK_APPEND_CLOSE);
+    skFill();
+}
+
+TEST_CASE("SoftwarePathSimplify")
+{
+    SKcontext ctx = NewContext48();
+
+    SpikedRect();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(12, 11));
+
+    // within 4 pixels of the rectangle, so it goes
+    skPathSimplify(SK_SIMPLIFY_RDP, 4);
+    SpikedRect();
+    EXPECT_EQ(0x000000FF, ReadPixel(12, 11));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(12, 16));
+
+    // and at twice the size it is 6 pixels tall and stays
+    skScale(2, 2);
+    SpikedRect();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(24, 22));
+    skLoadIdentity();
+
+    // the columns keep the highest and lowest point of each
+    const SKscalar zigzag[10] = {10, 10, 10.2f, 30, 10.4f, 12, 10.6f, 28, 10.8f, 11};
+
+    skPathSimplify(SK_SIMPLIFY_MIN_MAX, 4);
+    skClearContext();
+    skClearPath();
+    skPathAppend(zigzag, 5, SK_APPEND_MOVE);
+    skStroke();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(10, 11));
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(10, 28));
+
+    skPathSimplify(SK_SIMPLIFY_NONE, 0);
+    SpikedRect();
+    EXPECT_EQ(0xFFFFFFFF, ReadPixel(12, 11));
+
+    skDeleteContext(ctx);
+}
+
+void DrawParallelScene(SKubyte* pixels, SKint32 index)
+{
+    // creating the context selects it on this thread, every
+    // call after that names its context explicitly
+    SKcontext ctx = skNewBackEndContext(SK_BE_Software);
+    skSetCurrentContext(nullptr);
+
+    skSetContext2iEx(ctx, SK_CONTEXT_SIZE, 48, 48);
+    skProjectContextEx(ctx, SK_STANDARD);
+    skClearEx(ctx, 0, 0, 48, 48);
+
+    for (SKint32 i = 0; i < 10; ++i)
+    {
+        skColor4fEx(ctx, SKscalar(i % 2), SKscalar(index) / 4.f, .5f, .75f);
+        skEllipseEx(ctx, SKscalar(i * 4), SKscalar(i * 3), 16, 12);
+        skFillEx(ctx);
+    }
+
+    SKfont font = skNewFontEx(ctx, SK_FONT_DEFAULT, 12, 72);
+    skDisplayStringEx(ctx, font, "Ex", 2, 4, 30);
+
+    skReadPixelsEx(ctx, 0, 0, 48, 48, pixels);
+    skDeleteFontEx(ctx, font);
+    skDeleteContext(ctx);
+}
+
+TEST_CASE("SoftwareParallelContexts")
+{
+    const SKint32 size = 48 * 48 * 4;
+
+    SKubyte* serial   = new SKubyte[size * 4];
+    SKubyte* parallel = new SKubyte[size * 4];
+
+    for (SKint32 i = 0; i < 4; ++i)
+        DrawParallelScene(serial + i * size, i);
+
+    SKcontext main = skNewBackEndContext(SK_BE_Software);
+
+    std::thread threads[4];
+    for (SKint32 i = 0; i < 4; ++i)
+        threads[i] = std::thread(DrawParallelScene, parallel + i * size, i);
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // the current context belongs to the calling thread
+    EXPECT_EQ(skGetCurrentContext(), main);
+
+    // fonts and images can be made without selecting a context
+    skSetCurrentContext(nullptr);
+    SKfont  font = skNewFontEx(main, SK_FONT_DEFAULT, 12, 72);
+    SKimage ima  = skNewImageEx(main);
+    EXPECT_NE(font, nullptr);
+    EXPECT_NE(ima, nullptr);
+    skDeleteFontEx(main, font);
+    skDeleteImageEx(main, ima);
+
+    EXPECT_EQ(0, memcmp(serial, parallel, size * 4));
+    EXPECT_NE(0, memcmp(serial, serial + size, size));
+
+    skDeleteContext(main);
+    delete[] serial;
+    delete[] parallel;
+}